@@ -3,7 +3,9 @@ param(
   [int[]]$ThreadsList = @(1,2,4,6,12),
   [string[]]$Schedules = @("static","dynamic:64","guided:64"),
   [int]$Steps = 1000,
-  [int]$Reps = 10
+  [int]$Reps = 10,
+  [string]$Bind = "close",     # none | close | spread (afinidad aplicada por el propio ejecutable)
+  [string]$Places = "cores"    # threads | cores | sockets | {0,1},{2,3}
 )
 
 # Validaciones rápidas
@@ -17,7 +19,7 @@ $bin  = Join-Path $root "build\mingw-release"
 $out  = Join-Path $root "data\results"
 New-Item -ItemType Directory -Force -Path $out | Out-Null
 
-# Quita variables de afinidad que rompen con libgomp en MinGW
+# Quita variables de afinidad que rompen con libgomp en MinGW (la afinidad va con --bind/--places)
 Remove-Item Env:OMP_PROC_BIND -ErrorAction SilentlyContinue
 Remove-Item Env:OMP_PLACES    -ErrorAction SilentlyContinue
 
@@ -41,11 +43,11 @@ foreach ($N in $NList) {
       $tag = ($S -replace "[:]", "_")
       foreach ($r in 1..$Reps) {
         $csv = Join-Path $out ("omp_for_N{0}_T{1}_S{2}_r{3}.csv" -f $N, $T, $tag, $r)
-        $cmd = "`"$bin\omp_for.exe`" --n $N --steps $Steps --threads $T --schedule $S --record `"$csv`""
+        $cmd = "`"$bin\omp_for.exe`" --n $N --steps $Steps --threads $T --schedule $S --bind $Bind --places $Places --record `"$csv`""
         Write-Output ("RUN  N={0}  T={1}  S={2}  r={3} -> {4}" -f $N,$T,$S,$r,$csv) | Tee-Object -FilePath $log -Append
         Write-Output ("CMD  {0}" -f $cmd) | Tee-Object -FilePath $log -Append
         try {
-          & "$bin\omp_for.exe" --n $N --steps $Steps --threads $T --schedule $S --record $csv
+          & "$bin\omp_for.exe" --n $N --steps $Steps --threads $T --schedule $S --bind $Bind --places $Places --record $csv
           Write-Output ("EXIT CODE: {0}" -f $LASTEXITCODE) | Tee-Object -FilePath $log -Append
         } catch {
           Write-Warning "Fallo en N=$N T=$T S=$S r=$r : $_"
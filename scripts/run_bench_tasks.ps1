@@ -3,7 +3,9 @@ param(
   [int[]]$ThreadsList = @(1,2,4,6,12),
   [string[]]$Schedules = @("static","dynamic:64","guided:64"),
   [int]$Steps = 1000,
-  [int]$Reps = 10
+  [int]$Reps = 10,
+  [string]$Bind = "close",     # none | close | spread (afinidad aplicada por el propio ejecutable)
+  [string]$Places = "cores"    # threads | cores | sockets | {0,1},{2,3}
 )
 
 $root = (Get-Location).Path
@@ -14,9 +16,9 @@ New-Item -ItemType Directory -Force -Path $out | Out-Null
 $stamp = Get-Date -Format "yyyyMMdd_HHmmss"
 $log = Join-Path $out "bench_tasks_$stamp.log"
 
-# Si aparece 'Affinity not supported', comenta estas dos:
-$env:OMP_PROC_BIND="close"
-$env:OMP_PLACES="cores"
+# La afinidad se pasa con --bind/--places: OMP_PROC_BIND/OMP_PLACES no funcionan con libgomp de MinGW
+Remove-Item Env:OMP_PROC_BIND -ErrorAction SilentlyContinue
+Remove-Item Env:OMP_PLACES    -ErrorAction SilentlyContinue
 
 Write-Output "Starting bench/TASKS at $stamp" | Tee-Object -FilePath $log -Append
 
@@ -30,7 +32,7 @@ foreach ($N in $NList) {
     foreach ($S in $Schedules) {
       foreach ($r in 1..$Reps) {
         $csv = Join-Path $out ("omp_tasks_N{0}_T{1}_S{2}_r{3}.csv" -f $N, $T, ($S -replace "[:]", "_"), $r)
-        & "$bin\omp_tasks.exe" --n $N --steps $Steps --threads $T --schedule $S --record $csv | Tee-Object -FilePath $log -Append
+        & "$bin\omp_tasks.exe" --n $N --steps $Steps --threads $T --schedule $S --bind $Bind --places $Places --record $csv | Tee-Object -FilePath $log -Append
       }
     }
   }
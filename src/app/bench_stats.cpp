@@ -0,0 +1,107 @@
+// src/app/bench_stats.cpp
+#include "bench_stats.hpp"
+#include "core/rng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static double median_of(std::vector<double>& v) {
+    std::sort(v.begin(), v.end());
+    return percentile_sorted(v, 50.0);
+}
+
+bool WarmupDetector::add(double ms) {
+    ++count;
+    if (count >= maxFrames) return true;
+    cur.push_back(ms);
+    if (cur.size() < window) return false;
+    const double m = median_of(cur);
+    cur.clear();
+    const bool stable = prevMedian > 0.0 && std::fabs(m - prevMedian) <= tol * prevMedian;
+    prevMedian = m;
+    return stable;
+}
+
+double percentile_sorted(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    const double pos = (p / 100.0) * double(sorted.size() - 1);
+    const size_t lo = size_t(pos);
+    const size_t hi = std::min(lo + 1, sorted.size() - 1);
+    const double t = pos - double(lo);
+    return sorted[lo] * (1.0 - t) + sorted[hi] * t;
+}
+
+BenchSummary summarize(const std::vector<double>& samples, int bootstrapIters, uint32_t seed) {
+    BenchSummary r;
+    r.n = samples.size();
+    if (samples.empty()) return r;
+
+    std::vector<double> v(samples);
+    std::sort(v.begin(), v.end());
+    r.min = v.front();
+    r.max = v.back();
+    r.median = percentile_sorted(v, 50.0);
+    r.p95 = percentile_sorted(v, 95.0);
+    r.p99 = percentile_sorted(v, 99.0);
+
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    r.mean = sum / double(r.n);
+    double sq = 0.0;
+    for (double x : v) sq += (x - r.mean) * (x - r.mean);
+    r.stddev = r.n > 1 ? std::sqrt(sq / double(r.n - 1)) : 0.0;
+
+    // Outliers por cercas de Tukey
+    const double q1 = percentile_sorted(v, 25.0), q3 = percentile_sorted(v, 75.0);
+    const double iqr = q3 - q1;
+    for (double x : v)
+        if (x < q1 - 1.5 * iqr || x > q3 + 1.5 * iqr) ++r.outliers;
+
+    // Bootstrap percentil de la mediana (semilla fija: resultados reproducibles)
+    if (bootstrapIters > 0 && r.n > 1) {
+        RNG rng(seed ? seed : 1u);
+        std::vector<double> meds(bootstrapIters), res(r.n);
+        for (int b = 0; b < bootstrapIters; ++b) {
+            for (size_t k = 0; k < r.n; ++k) res[k] = samples[rng.u32() % r.n];
+            meds[b] = median_of(res);
+        }
+        std::sort(meds.begin(), meds.end());
+        r.ciLo = percentile_sorted(meds, 2.5);
+        r.ciHi = percentile_sorted(meds, 97.5);
+    } else {
+        r.ciLo = r.ciHi = r.median;
+    }
+    return r;
+}
+
+bool append_summary(const std::string& path, const BenchConfig& c, const BenchSummary& s) {
+    const bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    bool isNew = true;
+    if (FILE* probe = std::fopen(path.c_str(), "rb")) {
+        std::fseek(probe, 0, SEEK_END);
+        isNew = std::ftell(probe) == 0;
+        std::fclose(probe);
+    }
+    FILE* f = std::fopen(path.c_str(), "ab");
+    if (!f) return false;
+    if (json) {
+        std::fprintf(f,
+            "{\"backend\":\"%s\",\"workload\":\"%s\",\"N\":%d,\"threads\":%d,\"schedule\":\"%s\",\"steps\":%d,\"reps\":%d,"
+            "\"warmup_frames\":%zu,\"samples\":%zu,\"outliers\":%zu,\"mean_ms\":%.6f,\"stddev_ms\":%.6f,"
+            "\"min_ms\":%.6f,\"median_ms\":%.6f,\"p95_ms\":%.6f,\"p99_ms\":%.6f,\"max_ms\":%.6f,"
+            "\"median_ci95_ms\":[%.6f,%.6f]}\n",
+            c.backend.c_str(), c.workload.c_str(), c.N, c.threads, c.schedule.c_str(), c.steps, c.reps,
+            c.warmupFrames, s.n, s.outliers, s.mean, s.stddev,
+            s.min, s.median, s.p95, s.p99, s.max, s.ciLo, s.ciHi);
+    } else {
+        if (isNew)
+            std::fputs("backend,workload,N,threads,schedule,steps,reps,warmup_frames,samples,outliers,"
+                       "mean_ms,stddev_ms,min_ms,median_ms,p95_ms,p99_ms,max_ms,ci95_lo_ms,ci95_hi_ms\n", f);
+        std::fprintf(f, "%s,%s,%d,%d,%s,%d,%d,%zu,%zu,%zu,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n",
+            c.backend.c_str(), c.workload.c_str(), c.N, c.threads, c.schedule.c_str(), c.steps, c.reps,
+            c.warmupFrames, s.n, s.outliers, s.mean, s.stddev,
+            s.min, s.median, s.p95, s.p99, s.max, s.ciLo, s.ciHi);
+    }
+    std::fclose(f);
+    return true;
+}
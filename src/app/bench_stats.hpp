@@ -0,0 +1,50 @@
+// src/app/bench_stats.hpp
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Resumen estadístico de una serie de tiempos por frame (ms)
+struct BenchSummary {
+    size_t n = 0;          // muestras usadas
+    size_t outliers = 0;   // fuera de las cercas de Tukey (Q1-1.5*IQR, Q3+1.5*IQR)
+    double mean = 0, stddev = 0;
+    double min = 0, median = 0, p95 = 0, p99 = 0, max = 0;
+    double ciLo = 0, ciHi = 0; // IC 95% bootstrap de la mediana
+};
+
+// Detector de warm-up adaptativo: recibe frames en ventanas y decide cuándo el tiempo se estabilizó
+// (mediana de dos ventanas consecutivas con diferencia relativa < tol) o se llegó a maxFrames.
+struct WarmupDetector {
+    size_t window = 20;
+    double tol = 0.05;
+    size_t maxFrames = 1000;
+
+    // Agrega un frame; devuelve true cuando el warm-up terminó
+    bool add(double ms);
+    size_t frames() const { return count; }
+
+private:
+    std::vector<double> cur;
+    double prevMedian = -1.0;
+    size_t count = 0;
+};
+
+// Percentil p en [0,100] con interpolación lineal sobre datos ya ordenados
+double percentile_sorted(const std::vector<double>& sorted, double p);
+// Calcula el resumen; bootstrapIters remuestreos para el IC de la mediana
+BenchSummary summarize(const std::vector<double>& samples, int bootstrapIters = 1000, uint32_t seed = 12345u);
+
+// Describe una configuración medida (una fila del resumen)
+struct BenchConfig {
+    std::string backend;
+    std::string workload;    // Backend::workload: qué hace cada paso (los tiempos solo se comparan a igual trabajo)
+    int N = 0, threads = 0, steps = 0, reps = 0;
+    std::string schedule;
+    size_t warmupFrames = 0; // promedio por repetición
+};
+
+// Agrega una fila al archivo de resumen. El formato se elige por extensión: .json escribe
+// JSON Lines (un objeto por línea), cualquier otra escribe CSV con encabezado si el archivo es nuevo.
+bool append_summary(const std::string& path, const BenchConfig& cfg, const BenchSummary& s);
@@ -6,19 +6,38 @@
 #include <stdexcept>
 #include <cstdio>
 #include <algorithm>
-#include <thread> 
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include "core/state.hpp"
 #include "core/physics.hpp"
-#include "omp/update_seq.hpp"
-#include "omp/update_omp_for.hpp"
-#include "omp/update_omp_simd.hpp"
-#include "omp/update_omp_tasks.hpp"
+#include "core/sim_context.hpp"
+#include "core/reorder.hpp"
+#include "core/profile.hpp"
+#include "core/triple_buffer.hpp"
+#include "core/affinity.hpp"
+#include "core/snapshot.hpp"
+#include "core/trajectory.hpp"
+#include "omp/backends.hpp"
 #include "gfx/renderer.hpp"
+#include "app/bench_stats.hpp"
 
 #ifdef _OPENMP
   #include <omp.h>
 #endif
 
+// Backend por defecto según el ejecutable (seq, omp_for, ...); el binario único usa seq
+#if defined(BUILD_MODE_OMP_TASKS)
+static const char* DEFAULT_BACKEND = "omp_tasks";
+#elif defined(BUILD_MODE_OMP_SIMD)
+static const char* DEFAULT_BACKEND = "omp_simd";
+#elif defined(BUILD_MODE_OMP_FOR)
+static const char* DEFAULT_BACKEND = "omp_for";
+#else
+static const char* DEFAULT_BACKEND = "seq";
+#endif
+
 // -------------------- CLI --------------------
 struct Args {
     int N = 1000;
@@ -26,6 +45,25 @@ struct Args {
     int threads = 0;         // 0 = auto (OpenMP decide)
     std::string recordCsv;   // si no vacío, escribe CSV
     std::string schedule = "static"; // static | dynamic[:chunk] | guided[:chunk]
+    int reorderEvery = 0;    // 0 = sin reordenamiento Morton
+    std::string backend = DEFAULT_BACKEND; // nombre | lista separada por comas | all
+    int reps = 1;            // repeticiones por backend (State nuevo en cada una)
+    int warmup = -1;         // frames de warm-up; -1 = adaptativo
+    std::string summary;     // si no vacío, agrega una fila de resumen (.json o .csv)
+    std::string trace;       // si no vacío, exporta zonas de perfilado (requiere ENABLE_PROFILING)
+    bool async = false;      // simulación en su propio hilo; el render consume el último frame publicado
+    float hz = 60.0f;        // pasos de simulación por segundo simulado (dt = 1/hz)
+    bool realtime = false;   // paso fijo acoplado al reloj de pared, render interpolado
+    int maxSubsteps = 8;     // pasos máximos por frame de render en --realtime
+    std::string bind = "none";   // afinidad de los hilos OpenMP: none | close | spread
+    std::string places = "cores"; // threads | cores | sockets | {0,1},{2,3}
+    int snapshotEvery = 0;   // guardar un snapshot cada K pasos (0 = nunca)
+    std::string snapshot = "snapshot_{step}.bin"; // ruta de los snapshots ({step} = paso)
+    std::string restore;     // si no vacío, arranca desde este snapshot en lugar de la semilla
+    std::string trajectory;  // si no vacío, graba las posiciones de cada paso (comprimidas)
+    float trajectoryTolerance = 0.25f; // error máximo en píxeles de la trayectoria grabada
+    std::string frameOut;    // si no vacío, el renderer guarda ahí el último frame (si tiene framebuffer)
+    int frameEvery = 0;      // con --frame-out: guardar un frame cada K frames dibujados (0 = solo el último)
 };
 
 static void print_usage(const char* prog) {
@@ -37,7 +75,29 @@ static void print_usage(const char* prog) {
       << "  --threads INT       Numero de hilos (1..num_procs). 0 = auto\n"
       << "  --schedule STR      static | dynamic:CHUNK | guided:CHUNK\n"
       << "  --record path.csv   Archivo CSV para registrar tiempos por frame\n"
-      << "  --help              Muestra esta ayuda\n";
+      << "  --reorder INT       Reordenar particulas por codigo Morton cada INT pasos (0 = nunca)\n"
+      << "  --backend STR       Backend: nombre, lista separada por comas o 'all' (default: " << DEFAULT_BACKEND << ")\n"
+      << "  --reps INT          Repeticiones por backend (>=1)\n"
+      << "  --warmup auto|INT   Frames de warm-up: 'auto' espera a que el tiempo se estabilice (default)\n"
+      << "  --summary path      Agrega resumen (mediana, p95, p99, stddev, IC95, outliers) en .json o .csv\n"
+      << "  --trace path.json   Exporta zonas de perfilado en formato Chrome trace/Perfetto (build con ENABLE_PROFILING)\n"
+      << "  --async             Simulacion y render en paralelo (triple buffer); el render muestra el ultimo frame\n"
+      << "  --hz FLOAT          Frecuencia de la simulacion: paso fijo dt = 1/hz (default 60)\n"
+      << "  --realtime          Paso fijo con acumulador sobre el reloj de pared e interpolacion en el render\n"
+      << "  --max-substeps INT  Pasos maximos por frame de render en --realtime (default 8)\n"
+      << "  --bind STR          Atar hilos OpenMP: none | close | spread (como OMP_PROC_BIND, default none)\n"
+      << "  --places STR        Lugares para --bind: threads | cores | sockets | {0,1},{2-3} (default cores)\n"
+      << "  --snapshot-every K  Guarda un snapshot binario del State cada K pasos (en segundo plano)\n"
+      << "  --snapshot path     Ruta de los snapshots; {step} se reemplaza por el paso (default snapshot_{step}.bin)\n"
+      << "  --restore path      Arranca desde un snapshot (mapeado en memoria) en lugar de --n y la semilla\n"
+      << "  --trajectory path   Graba las posiciones de cada paso, comprimidas y en segundo plano (descarta si se atrasa)\n"
+      << "  --trajectory-tolerance PX  Error maximo de las posiciones grabadas en pixeles (default 0.25)\n"
+      << "  --frame-out path    Guarda el ultimo frame dibujado como .png o .ppm (renderers por software, p. ej. screensaver_soft)\n"
+      << "  --frame-every K     Con --frame-out, guarda un frame cada K en segundo plano; {frame} en la ruta = numero de frame\n"
+      << "  --help              Muestra esta ayuda\n\n"
+      << "Backends:";
+    for (const auto& b : backends()) std::cout << "\n  " << b.name << " (" << b.workload << ")";
+    std::cout << "\n";
 }
 
 static Args parse_args(int argc, char** argv) {
@@ -53,6 +113,25 @@ static Args parse_args(int argc, char** argv) {
         else if (s == "--threads")  a.threads = std::stoi(next());
         else if (s == "--record")   a.recordCsv = next();
         else if (s == "--schedule") a.schedule = next();
+        else if (s == "--reorder")  a.reorderEvery = std::stoi(next());
+        else if (s == "--backend")  a.backend = next();
+        else if (s == "--reps")     a.reps = std::stoi(next());
+        else if (s == "--summary")  a.summary = next();
+        else if (s == "--trace")    a.trace = next();
+        else if (s == "--async")    a.async = true;
+        else if (s == "--hz")       a.hz = std::stof(next());
+        else if (s == "--realtime") a.realtime = true;
+        else if (s == "--max-substeps") a.maxSubsteps = std::stoi(next());
+        else if (s == "--bind")     a.bind = next();
+        else if (s == "--places")   a.places = next();
+        else if (s == "--snapshot-every") a.snapshotEvery = std::stoi(next());
+        else if (s == "--snapshot") a.snapshot = next();
+        else if (s == "--restore")  a.restore = next();
+        else if (s == "--trajectory") a.trajectory = next();
+        else if (s == "--frame-out") a.frameOut = next();
+        else if (s == "--frame-every") a.frameEvery = std::stoi(next());
+        else if (s == "--trajectory-tolerance") a.trajectoryTolerance = std::stof(next());
+        else if (s == "--warmup")   { const auto v = next(); a.warmup = (v == "auto") ? -1 : std::stoi(v); }
         else if (s == "--help")     { print_usage(argv[0]); std::exit(0); }
         else {
             std::cerr << "[warn] Opcion desconocida: " << s << "\n";
@@ -60,6 +139,17 @@ static Args parse_args(int argc, char** argv) {
     }
     if (a.N < 1)    throw std::runtime_error("--n debe ser >= 1");
     if (a.steps < 1)throw std::runtime_error("--steps debe ser >= 1");
+    if (a.reorderEvery < 0) throw std::runtime_error("--reorder debe ser >= 0");
+    if (a.reps < 1)  throw std::runtime_error("--reps debe ser >= 1");
+    if (a.warmup < -1) throw std::runtime_error("--warmup debe ser 'auto' o >= 0");
+    if (!(a.hz > 0.0f)) throw std::runtime_error("--hz debe ser > 0");
+    if (a.maxSubsteps < 1) throw std::runtime_error("--max-substeps debe ser >= 1");
+    if (a.realtime && a.async) throw std::runtime_error("--realtime y --async no se pueden combinar");
+    if (a.snapshotEvery < 0) throw std::runtime_error("--snapshot-every debe ser >= 0");
+    if (a.frameEvery < 0) throw std::runtime_error("--frame-every debe ser >= 0");
+    if (!(a.trajectoryTolerance > 0.0f)) throw std::runtime_error("--trajectory-tolerance debe ser > 0");
+    if (a.bind != "none" && a.bind != "close" && a.bind != "spread")
+        throw std::runtime_error("--bind debe ser none, close o spread");
     return a;
 }
 
@@ -130,6 +220,263 @@ static void configure_openmp_schedule(const std::string& sch_raw) {
 }
 #endif // _OPENMP
 
+// Traduce --backend a la lista de backends a ejecutar (en orden)
+static std::vector<const Backend*> resolve_backends(const std::string& spec) {
+    std::vector<const Backend*> out;
+    if (spec == "all") {
+        for (const auto& b : backends()) out.push_back(&b);
+        return out;
+    }
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) end = spec.size();
+        const std::string name = spec.substr(start, end - start);
+        const Backend* b = find_backend(name);
+        if (!b) throw std::runtime_error("--backend desconocido: " + name);
+        out.push_back(b);
+        start = end + 1;
+    }
+    return out;
+}
+
+// Si se corren varios backends, cada CSV lleva el nombre del backend: out.csv -> out_omp_for.csv
+static std::string csv_path_for(const std::string& path, const char* backend, bool multi) {
+    if (!multi) return path;
+    const auto dot = path.find_last_of('.');
+    const auto slash = path.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return path + "_" + backend;
+    return path.substr(0, dot) + "_" + backend + path.substr(dot);
+}
+
+// Resultado de una repetición
+struct RunResult {
+    std::vector<double> samples; // ms por frame medido
+    size_t warmupFrames = 0;     // frames descartados como warm-up
+    size_t rendered = 0;         // frames dibujados durante la medición
+    double wallMs = 0.0;         // tiempo de pared de la medición (simulación + render)
+    std::chrono::steady_clock::time_point measureStart; // fin del warm-up
+};
+
+// Warm-up: fijo o hasta que el tiempo por frame se estabilice
+static void warm_up(const Args& args, const std::function<void()>& step, RunResult& r) {
+    using clock = std::chrono::steady_clock;
+    if (args.warmup >= 0) {
+        for (int i = 0; i < args.warmup; ++i) step();
+        r.warmupFrames = size_t(args.warmup);
+    } else {
+        WarmupDetector wd;
+        bool done = false;
+        while (!done) {
+            const auto t0 = clock::now();
+            step();
+            done = wd.add(std::chrono::duration<double, std::milli>(clock::now() - t0).count());
+        }
+        r.warmupFrames = wd.frames();
+    }
+    r.samples.reserve(args.steps);
+    r.measureStart = clock::now();
+}
+
+// Un paso medido: agrega su duración a las muestras
+static void timed_step(const std::function<void()>& step, RunResult& r) {
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    step();
+    r.samples.push_back(std::chrono::duration<double, std::milli>(clock::now() - t0).count());
+}
+
+// Warm-up + medición de 'steps' pasos. afterFrame corre tras cada paso medido, fuera del tiempo del paso.
+static void simulate(const Args& args, const std::function<void()>& step,
+                     const std::function<void()>& afterFrame, RunResult& r) {
+    warm_up(args, step, r);
+    for (int i = 0; i < args.steps; ++i) {
+        timed_step(step, r);
+        afterFrame();
+    }
+}
+
+// Corre un backend desde un State nuevo (misma semilla) y devuelve el tiempo de cada frame
+static RunResult run_backend(const Backend& b, const Args& args, IRenderer& renderer, bool multi) {
+    // Estado inicial: semilla fija o snapshot (los arreglos apuntan al archivo mapeado)
+    long long restoredStep = 0;
+    State s = args.restore.empty() ? State(args.N, 1280, 720, /*seed*/ 42)
+                                   : load_snapshot(args.restore, &restoredStep);
+    SimContext ctx(s.width, s.height);
+    ctx.step = restoredStep;
+    if (!args.restore.empty()) {
+        if (multi) std::cout << "[" << b.name << "] ";
+        std::cout << "Restore: " << args.restore << " N=" << s.N << " paso=" << restoredStep
+                  << (s.N != args.N ? " (ignora --n)" : "") << "\n";
+    }
+    ctx.reorderEvery = args.reorderEvery;
+    ctx.dt = 1.0f / args.hz;
+
+    // Backends que simulan en otro formato (compact) bajan su estado al State antes de usarlo
+    auto present = [&]() { if (b.sync) b.sync(s, ctx); };
+
+    std::unique_ptr<SnapshotWriter> snapshots;
+    if (args.snapshotEvery > 0)
+        snapshots = std::make_unique<SnapshotWriter>(csv_path_for(args.snapshot, b.name, multi));
+    std::unique_ptr<TrajectoryWriter> trajectory;
+    if (!args.trajectory.empty())
+        trajectory = std::make_unique<TrajectoryWriter>(csv_path_for(args.trajectory, b.name, multi),
+                                                        s.N, s.width, s.height, args.trajectoryTolerance);
+
+    // Un paso completo: backend + reordenamiento periódico + salidas a disco (en segundo plano)
+    auto step = [&]() {
+        PROF_ZONE("step");
+        b.step(s, ctx);
+        ++ctx.step;
+        reorder_if_due(s, ctx);
+        const bool snap = snapshots && ctx.step % args.snapshotEvery == 0;
+        if (snap || trajectory) present();
+        if (snap) {
+            PROF_ZONE("snapshot_submit");
+            snapshots->submit(s, ctx.step);
+        }
+        if (trajectory) {
+            PROF_ZONE("trajectory_submit");
+            trajectory->submit(s, ctx.step);
+        }
+    };
+
+    // Al salir (también por excepción) espera las escrituras pendientes e informa
+    struct OutputReport {
+        SnapshotWriter* snap;
+        TrajectoryWriter* traj;
+        const char* prefix;
+        int n;
+        ~OutputReport() {
+            if (snap) {
+                snap->flush();
+                if (prefix) std::cout << "[" << prefix << "] ";
+                std::cout << "Snapshots: escritos=" << snap->written() << " omitidos=" << snap->skipped()
+                          << " fallidos=" << snap->failed() << "\n";
+            }
+            if (traj) {
+                traj->flush();
+                const long long frames = traj->frames();
+                if (prefix) std::cout << "[" << prefix << "] ";
+                std::cout << "Trayectoria: frames=" << frames << " descartados=" << traj->dropped()
+                          << " bytes=" << traj->bytes();
+                if (frames > 0 && n > 0)
+                    std::cout << " (" << double(traj->bytes()) / (double(frames) * n) << " bytes/particula/frame)";
+                if (traj->failed()) std::cout << " ERROR de escritura";
+                std::cout << "\n";
+            }
+        }
+    } report{ snapshots.get(), trajectory.get(), multi ? b.name : nullptr, s.N };
+
+    using clock = std::chrono::steady_clock;
+    RunResult r;
+
+    auto draw = [&](const State& frame) {
+        PROF_ZONE("render");
+        renderer.beginFrame();
+        renderer.drawState(frame);
+        renderer.endFrame();
+        ++r.rendered;
+    };
+
+    if (args.realtime) {
+        // Paso fijo: el reloj de pared llena un acumulador y se simulan tantos pasos de ctx.dt como
+        // quepan (hasta maxSubsteps; el resto se descarta para no entrar en espiral). El render
+        // dibuja prev + (s - prev)*alpha con alpha = fracción de paso que quedó en el acumulador.
+        warm_up(args, step, r);
+        State prev = s, view = s;
+        bool prevValid = true;  // falso si el último paso reordenó los arreglos (índices distintos)
+        bool viewStale = true;  // view tiene vx, vy, color e id de un paso anterior
+        const double dtMs = 1000.0 * ctx.dt;
+        double acc = 0.0;
+        auto last = clock::now();
+        while (r.samples.size() < size_t(args.steps)) {
+            const auto now = clock::now();
+            acc += std::chrono::duration<double, std::milli>(now - last).count();
+            last = now;
+            int sub = 0;
+            while (acc >= dtMs && sub < args.maxSubsteps && r.samples.size() < size_t(args.steps)) {
+                present();
+                prev.x = s.x; prev.y = s.y;
+                const long long before = ctx.step;
+                timed_step(step, r);
+                prevValid = !(ctx.reorderEvery > 0 && ctx.step != before && ctx.step % ctx.reorderEvery == 0);
+                viewStale = true;
+                acc -= dtMs;
+                ++sub;
+            }
+            if (sub == args.maxSubsteps) acc = std::min(acc, dtMs);
+            const float alpha = float(std::min(1.0, acc / dtMs));
+            present();
+            if (prevValid) {
+                interpolate_state(prev, s, alpha, view, viewStale);
+                viewStale = false;
+                draw(view);
+            } else {
+                draw(s);
+            }
+        }
+        r.wallMs = std::chrono::duration<double, std::milli>(clock::now() - r.measureStart).count();
+        return r;
+    }
+
+    if (!args.async) {
+        // Serial: paso y render alternados sobre el mismo State
+        simulate(args, step, [&]() { present(); draw(s); }, r);
+        r.wallMs = std::chrono::duration<double, std::milli>(clock::now() - r.measureStart).count();
+        return r;
+    }
+
+    // Asíncrono: la simulación corre en su propio hilo (con su propio equipo OpenMP) y publica
+    // cada frame medido en el triple buffer; este hilo (el del renderer) dibuja el último publicado.
+    TripleBuffer<State> frames(s);
+    std::atomic<bool> finished{false};
+    std::exception_ptr simError;
+#ifdef _OPENMP
+    // Los ICV de OpenMP (hilos, schedule) son por hilo: el hilo nuevo hereda los del proceso, no los de main
+    const int nthreads = omp_get_max_threads();
+    omp_sched_t kind; int chunk;
+    omp_get_schedule(&kind, &chunk);
+#endif
+    std::thread sim([&]() {
+#ifdef _OPENMP
+        omp_set_num_threads(nthreads);
+        omp_set_schedule(kind, chunk);
+#endif
+        // El equipo de este hilo es nuevo: se ata con la misma configuración que el de main
+        if (args.bind != "none") pin_openmp_team(make_places(args.places), args.bind);
+        try {
+            simulate(args, step, [&]() {
+                present();
+                frames.back() = s;  // copia SoA sin realocar (mismo N)
+                frames.publish();
+            }, r);
+        } catch (...) {
+            simError = std::current_exception();
+        }
+        finished.store(true, std::memory_order_release);
+    });
+
+    // El render no debe competir con el hilo 0 de la simulación por el mismo lugar
+    if (args.bind != "none") unpin_current_thread();
+    for (;;) {
+        const bool last = finished.load(std::memory_order_acquire);
+        if (const State* frame = frames.latest()) {
+            draw(*frame);
+        } else if (last) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    sim.join();
+    if (args.bind != "none") pin_worker(0, 1);  // main vuelve a ser el hilo 0 del equipo
+    if (simError) std::rethrow_exception(simError);
+    r.wallMs = std::chrono::duration<double, std::milli>(clock::now() - r.measureStart).count();
+    return r;
+}
+
 // -------------------- main --------------------
 int main(int argc, char** argv) {
     try {
@@ -138,7 +485,15 @@ int main(int argc, char** argv) {
 #ifdef _OPENMP
         configure_openmp_threads(args.threads);
         configure_openmp_schedule(args.schedule);
-#else
+#endif
+        // Afinidad desde el programa (OMP_PLACES/OMP_PROC_BIND se leen antes de main)
+        if (args.bind != "none") {
+            const auto places = make_places(args.places);
+            const int pinned = pin_openmp_team(places, args.bind);
+            std::cout << "Bind: " << args.bind << " places=" << args.places << " (" << places.size()
+                      << " lugares), hilos atados: " << pinned << "\n";
+        }
+#ifndef _OPENMP
         if (args.threads != 0) {
             std::cerr << "[warn] Build sin OpenMP. --threads no tendra efecto.\n";
         }
@@ -147,63 +502,87 @@ int main(int argc, char** argv) {
         }
 #endif
 
-        // Estado inicial
-        State s(args.N, 1280, 720, /*seed*/ 42);
-        RendererConfig rcfg{1280, 720, /*vsync*/ false};
+        const auto selected = resolve_backends(args.backend);
+        const bool multi = selected.size() > 1;
+
+        RendererConfig rcfg{1280, 720, /*vsync*/ false, args.frameOut, args.frameEvery};
         RendererPtr renderer = createRenderer(rcfg); 
 
-        // Elegir backend según macro de build
-        auto step_fn =
-        #if defined(BUILD_MODE_OMP_TASKS)
-            update_step_omp_tasks;
-        #elif defined(BUILD_MODE_OMP_SIMD)
-            update_step_omp_simd;
-        #elif defined(BUILD_MODE_OMP_FOR)
-            update_step_omp_for;
-        #else
-            update_step_seq;
-        #endif
-
-        // Warm-up
-        for (int i = 0; i < 50; ++i) step_fn(s);
-
-        // Medición
-        using clock = std::chrono::steady_clock;
-        std::vector<double> samples;
-        samples.reserve(args.steps);
-
-        for (int i = 0; i < args.steps; ++i) {
-            const auto t0 = clock::now();
-            step_fn(s);
-            const auto t1 = clock::now();
-            const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
-            samples.push_back(ms);
-
-            renderer->beginFrame();
-            renderer->drawState(s);
-            renderer->endFrame();
-        }
+        for (const Backend* b : selected) {
+            std::vector<RunResult> runs;
+            std::vector<double> all;
+            size_t warmupTotal = 0, renderedTotal = 0;
+            double wallTotal = 0.0;
+            for (int rep = 0; rep < args.reps; ++rep) {
+                runs.push_back(run_backend(*b, args, *renderer, multi));
+                all.insert(all.end(), runs.back().samples.begin(), runs.back().samples.end());
+                warmupTotal += runs.back().warmupFrames;
+                renderedTotal += runs.back().rendered;
+                wallTotal += runs.back().wallMs;
+            }
+
+            // Reporte básico
+            const BenchSummary st = summarize(all);
+            if (multi) std::cout << "[" << b->name << "] ";
+            std::cout << "Frames: " << all.size() << "  Avg step (ms): " << st.mean
+                      << "  workload=" << b->workload << "\n";
+            std::cout << "  median=" << st.median << " p95=" << st.p95 << " p99=" << st.p99
+                      << " sd=" << st.stddev << " CI95(median)=[" << st.ciLo << ", " << st.ciHi << "]"
+                      << " outliers=" << st.outliers << " warmup=" << warmupTotal / runs.size() << "\n";
+            // Frames simulados por segundo de pared, con el render incluido (serial: suma; --async: máximo)
+            std::cout << "  throughput=" << (wallTotal > 0.0 ? 1000.0 * all.size() / wallTotal : 0.0) << " fps"
+                      << " rendered=" << renderedTotal << (args.async ? " (async)" : "") << "\n";
+
+            if (!args.summary.empty()) {
+                BenchConfig cfg;
+                cfg.backend = b->name;
+                cfg.workload = b->workload;
+                cfg.N = args.N;
+#ifdef _OPENMP
+                cfg.threads = omp_get_max_threads();
+#else
+                cfg.threads = 1;
+#endif
+                cfg.schedule = args.schedule;
+                cfg.steps = args.steps;
+                cfg.reps = args.reps;
+                cfg.warmupFrames = warmupTotal / runs.size();
+                if (!append_summary(args.summary, cfg, st))
+                    std::cerr << "[error] No se pudo escribir el resumen en: " << args.summary << ". Continuando.\n";
+            }
 
-        // Reporte básico
-        double sum = 0.0;
-        for (double v : samples) sum += v;
-        const double avg = sum / samples.size();
-        std::cout << "Frames: " << samples.size() << "  Avg step (ms): " << avg << "\n";
-
-        // Guardar CSV (si falla: informar y continuar sin romper)
-        if (!args.recordCsv.empty()) {
-            if (FILE* f = std::fopen(args.recordCsv.c_str(), "wb")) {
-                std::fputs("frame,ms\n", f);
-                for (size_t i = 0; i < samples.size(); ++i) {
-                    std::fprintf(f, "%zu,%.6f\n", i, samples[i]);
+            // Guardar CSV (si falla: informar y continuar sin romper). Con --reps > 1 se agrega la columna rep.
+            if (!args.recordCsv.empty()) {
+                const std::string path = csv_path_for(args.recordCsv, b->name, multi);
+                if (FILE* f = std::fopen(path.c_str(), "wb")) {
+                    const bool withRep = runs.size() > 1;
+                    std::fputs(withRep ? "rep,frame,ms\n" : "frame,ms\n", f);
+                    for (size_t r = 0; r < runs.size(); ++r) {
+                        const auto& samples = runs[r].samples;
+                        for (size_t i = 0; i < samples.size(); ++i) {
+                            if (withRep) std::fprintf(f, "%zu,", r);
+                            std::fprintf(f, "%zu,%.6f\n", i, samples[i]);
+                        }
+                    }
+                    std::fclose(f);
+                    std::cout << "CSV written: " << path << "\n";
+                } else {
+                    std::cerr << "[error] No se pudo escribir CSV en: " << path
+                              << " (ruta inexistente o sin permisos). Continuando.\n";
                 }
-                std::fclose(f);
-                std::cout << "CSV written: " << args.recordCsv << "\n";
-            } else {
-                std::cerr << "[error] No se pudo escribir CSV en: " << args.recordCsv
-                          << " (ruta inexistente o sin permisos). Continuando.\n";
             }
         }
+
+        if (!args.trace.empty()) {
+#ifdef PROFILING_ENABLED
+            if (prof::write_chrome_trace(args.trace.c_str()))
+                std::cout << "Trace written: " << args.trace << "\n";
+            else
+                std::cerr << "[error] No se pudo escribir el trace en: " << args.trace << ". Continuando.\n";
+#else
+            std::cerr << "[warn] Build sin ENABLE_PROFILING. --trace no tendra efecto.\n";
+#endif
+        }
     } catch (const std::exception& e) {
         std::cerr << "[error] " << e.what() << "\n";
         return 1;
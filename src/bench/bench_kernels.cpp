@@ -0,0 +1,246 @@
+// src/bench/bench_kernels.cpp
+// Microbenchmarks de cada kernel por separado (integrate, bounce, Grid::build, update_step_*),
+// barriendo N, hilos y schedule. Reporta tiempo por iteración, partículas/s y bytes/s.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "core/state.hpp"
+#include "core/physics.hpp"
+#include "core/compact_state.hpp"
+#include "core/grid.hpp"
+#include "core/sim_context.hpp"
+#include "omp/backends.hpp"
+#include "app/bench_stats.hpp"
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+// -------------------- CLI --------------------
+struct Args {
+    std::vector<int> Ns = {1000, 10000, 100000};
+    std::vector<int> threads = {1};
+    std::vector<std::string> schedules = {"static"};
+    std::string filter;      // si no vacío, solo kernels cuyo nombre lo contiene
+    double minTime = 0.1;    // segundos mínimos por lote
+    int batches = 10;        // lotes medidos por caso
+    std::string csv;
+};
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    size_t start = 0;
+    while (start <= s.size()) {
+        size_t end = s.find(',', start);
+        if (end == std::string::npos) end = s.size();
+        if (end > start) out.push_back(s.substr(start, end - start));
+        start = end + 1;
+    }
+    return out;
+}
+
+static std::vector<int> split_ints(const std::string& s) {
+    std::vector<int> out;
+    for (const auto& t : split(s)) out.push_back(std::stoi(t));
+    return out;
+}
+
+static void print_usage(const char* prog) {
+    std::cout
+      << "Uso: " << prog << " [opciones]\n\n"
+      << "Opciones:\n"
+      << "  --n LIST            Tamaños a medir, separados por coma (default 1000,10000,100000)\n"
+      << "  --threads LIST      Hilos para los kernels paralelos (default 1)\n"
+      << "  --schedule LIST     static | dynamic:CHUNK | guided:CHUNK, separados por coma\n"
+      << "  --filter STR        Solo kernels cuyo nombre contiene STR\n"
+      << "  --min-time SEC      Tiempo mínimo por lote (default 0.1)\n"
+      << "  --batches INT       Lotes por caso (default 10)\n"
+      << "  --csv path.csv      Escribe los resultados en CSV\n"
+      << "  --help              Muestra esta ayuda\n";
+}
+
+static Args parse_args(int argc, char** argv) {
+    Args a;
+    for (int i = 1; i < argc; ++i) {
+        std::string s = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 < argc) return std::string(argv[++i]);
+            throw std::runtime_error("Falta valor para " + s);
+        };
+        if      (s == "--n")        a.Ns = split_ints(next());
+        else if (s == "--threads")  a.threads = split_ints(next());
+        else if (s == "--schedule") a.schedules = split(next());
+        else if (s == "--filter")   a.filter = next();
+        else if (s == "--min-time") a.minTime = std::stod(next());
+        else if (s == "--batches")  a.batches = std::stoi(next());
+        else if (s == "--csv")      a.csv = next();
+        else if (s == "--help")     { print_usage(argv[0]); std::exit(0); }
+        else {
+            std::cerr << "[warn] Opcion desconocida: " << s << "\n";
+        }
+    }
+    if (a.Ns.empty() || a.threads.empty() || a.schedules.empty())
+        throw std::runtime_error("--n, --threads y --schedule no pueden estar vacios");
+    if (a.batches < 1) throw std::runtime_error("--batches debe ser >= 1");
+    return a;
+}
+
+#ifdef _OPENMP
+static void set_schedule(const std::string& sch) {
+    auto pos = sch.find(':');
+    const std::string name = sch.substr(0, pos);
+    const int chunk = (pos == std::string::npos) ? 0 : std::stoi(sch.substr(pos + 1));
+    if      (name == "static")  omp_set_schedule(omp_sched_static, chunk);
+    else if (name == "dynamic") omp_set_schedule(omp_sched_dynamic, chunk);
+    else if (name == "guided")  omp_set_schedule(omp_sched_guided, chunk);
+    else throw std::runtime_error("schedule invalido: " + sch);
+}
+#endif
+
+// -------------------- Kernels --------------------
+// Cada caso tiene su propio State/SimContext; bytesPerParticle es el tráfico mínimo estimado
+// (lecturas + escrituras de los arreglos SoA), no una medición de hardware.
+struct Kernel {
+    std::string name;
+    bool parallel;            // si depende de hilos/schedule
+    double bytesPerParticle;
+    std::function<void(State&, SimContext&)> fn;
+};
+
+// Tráfico de un update_step_* según su Backend::workload: suma las fases que hace, con los mismos
+// bytes que sus kernels sueltos. collide lee el índice de sorted (4 B) y lee y escribe x, y, vx, vy
+// (32 B); las vecinas ya están en caché porque cada celda es un rango contiguo.
+static double workload_bytes(const std::string& w) {
+    static const struct { const char* phase; double bytes; } PHASES[] = {
+        { "integrate_fixed", 20.0 }, { "integrate", 32.0 },
+        { "grid_update", 12.0 }, { "grid_sorted", 24.0 }, { "collide", 36.0 },
+    };
+    double total = 0.0;
+    size_t pos = 0;
+    while (pos <= w.size()) {
+        const size_t end = std::min(w.find('+', pos), w.size());
+        const std::string phase = w.substr(pos, end - pos);
+        bool known = false;
+        for (const auto& p : PHASES)
+            if (phase == p.phase) { total += p.bytes; known = true; }
+        if (!known) throw std::runtime_error("fase de workload sin modelo de trafico: " + phase);
+        pos = end + 1;
+    }
+    return total;
+}
+
+static std::vector<Kernel> make_kernels() {
+    std::vector<Kernel> ks = {
+        { "integrate",        false, 24.0, [](State& s, SimContext& c) { integrate(s, c.dt); } },
+        { "bounce",           false, 32.0, [](State& s, SimContext&) { bounce(s); } },
+        { "integrate_bounce", false, 32.0, [](State& s, SimContext& c) { integrate_bounce(s, c.dt, 0, s.N); } },
+        { "grid_build",       false, 16.0, [](State& s, SimContext& c) { c.grid.build(s); } },
+        { "grid_update",      false, 12.0, [](State& s, SimContext& c) { c.grid.update(s); } },
+        { "grid_build_sorted", true, 24.0, [](State& s, SimContext& c) { c.grid.buildSorted(s); } },
+        { "compact_integrate_bounce", false, 20.0, [](State& s, SimContext& c) {
+              if (!c.compact.live) compact_pack(s, c.compact);
+              compact_integrate_bounce(c.compact, s.N, c.dt, 0, s.N); } },
+    };
+    for (const auto& b : backends()) {
+        StepFn f = b.step;
+        const bool par = std::string(b.name) != "seq";
+        ks.push_back({ std::string("update_step_") + b.name, par, workload_bytes(b.workload),
+                       [f](State& s, SimContext& c) { f(s, c); } });
+    }
+    return ks;
+}
+
+struct Result {
+    std::string kernel, schedule;
+    int N, threads;
+    long long iters;
+    BenchSummary ns;   // ns por iteración
+};
+
+// Calibra las iteraciones por lote para durar al menos minTime y mide 'batches' lotes
+static Result run_case(const Kernel& k, int N, int threads, const std::string& sch, const Args& a) {
+    using clock = std::chrono::steady_clock;
+    State s(N, 1280, 720, /*seed*/ 42);
+    SimContext ctx(s.width, s.height);
+    fit_grid(ctx.grid, s);
+    k.fn(s, ctx); // warm-up (construye el grid, resuelve el despacho SIMD)
+
+    long long iters = 1;
+    for (;;) {
+        const auto t0 = clock::now();
+        for (long long i = 0; i < iters; ++i) k.fn(s, ctx);
+        const double sec = std::chrono::duration<double>(clock::now() - t0).count();
+        if (sec >= a.minTime || iters >= (1LL << 30)) break;
+        iters = sec <= 0.0 ? iters * 10 : std::max(iters + 1, (long long)(iters * a.minTime * 1.2 / sec));
+    }
+
+    std::vector<double> perIter;
+    for (int b = 0; b < a.batches; ++b) {
+        const auto t0 = clock::now();
+        for (long long i = 0; i < iters; ++i) k.fn(s, ctx);
+        perIter.push_back(std::chrono::duration<double, std::nano>(clock::now() - t0).count() / double(iters));
+    }
+    return { k.name, sch, N, threads, iters, summarize(perIter, 200) };
+}
+
+int main(int argc, char** argv) {
+    try {
+        const Args args = parse_args(argc, argv);
+        const auto kernels = make_kernels();
+        std::vector<Result> results;
+
+        std::printf("ISA integrate_bounce: %s  compact: %s\n", integrate_bounce_isa(), compact_integrate_bounce_isa());
+        std::printf("%-28s %9s %4s %-12s %12s %10s %14s %6s %12s\n",
+                    "Benchmark", "N", "T", "schedule", "median(us)", "cv(%)", "particles/s", "B/p", "GB/s(est)");
+        for (const auto& k : kernels) {
+            if (!args.filter.empty() && k.name.find(args.filter) == std::string::npos) continue;
+            for (int N : args.Ns) {
+                // Los kernels seriales se miden una sola vez por N
+                const std::vector<int> ts = k.parallel ? args.threads : std::vector<int>{1};
+                const std::vector<std::string> ss = k.parallel ? args.schedules : std::vector<std::string>{"-"};
+                for (int T : ts) {
+                    for (const auto& sch : ss) {
+#ifdef _OPENMP
+                        omp_set_num_threads(T);
+                        if (k.parallel) set_schedule(sch);
+#endif
+                        Result r = run_case(k, N, T, sch, args);
+                        const double sec = r.ns.median * 1e-9;
+                        const double pps = sec > 0 ? N / sec : 0.0;
+                        const double cv = r.ns.mean > 0 ? 100.0 * r.ns.stddev / r.ns.mean : 0.0;
+                        std::printf("%-28s %9d %4d %-12s %12.3f %10.2f %14.4g %6.0f %12.3f\n",
+                                    k.name.c_str(), N, T, sch.c_str(), r.ns.median * 1e-3, cv,
+                                    pps, k.bytesPerParticle, pps * k.bytesPerParticle * 1e-9);
+                        std::fflush(stdout);
+                        results.push_back(std::move(r));
+                    }
+                }
+            }
+        }
+
+        if (!args.csv.empty()) {
+            FILE* f = std::fopen(args.csv.c_str(), "wb");
+            if (!f) throw std::runtime_error("No se pudo escribir CSV en: " + args.csv);
+            std::fputs("kernel,N,threads,schedule,iters,median_ns,p95_ns,stddev_ns,ci95_lo_ns,ci95_hi_ns,particles_per_s,bytes_per_particle,bytes_per_s\n", f);
+            for (const auto& r : results) {
+                double bpp = 0.0;
+                for (const auto& k : kernels) if (k.name == r.kernel) bpp = k.bytesPerParticle;
+                const double pps = r.ns.median > 0 ? r.N / (r.ns.median * 1e-9) : 0.0;
+                std::fprintf(f, "%s,%d,%d,%s,%lld,%.3f,%.3f,%.3f,%.3f,%.3f,%.6g,%.1f,%.6g\n",
+                             r.kernel.c_str(), r.N, r.threads, r.schedule.c_str(), r.iters,
+                             r.ns.median, r.ns.p95, r.ns.stddev, r.ns.ciLo, r.ns.ciHi, pps, bpp, pps * bpp);
+            }
+            std::fclose(f);
+            std::cout << "CSV written: " << args.csv << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "[error] " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
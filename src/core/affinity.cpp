@@ -0,0 +1,210 @@
+// src/core/affinity.cpp
+#include "affinity.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <sched.h>
+#endif
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+namespace {
+
+// CPU lógica con su núcleo y paquete físicos
+struct Cpu { int id, core, socket; };
+
+#if defined(__linux__)
+int read_sys_int(int cpu, const char* leaf, int fallback) {
+    char path[128];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, leaf);
+    int v = fallback;
+    if (FILE* f = std::fopen(path, "r")) {
+        if (std::fscanf(f, "%d", &v) != 1) v = fallback;
+        std::fclose(f);
+    }
+    return v;
+}
+#endif
+
+// CPUs permitidas al proceso con su topología (sin topología: cada CPU es su propio núcleo)
+std::vector<Cpu> allowed_cpus() {
+    std::vector<Cpu> out;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c)
+            if (CPU_ISSET(c, &set))
+                out.push_back({ c, read_sys_int(c, "core_id", c), read_sys_int(c, "physical_package_id", 0) });
+    }
+#elif defined(_WIN32)
+    DWORD_PTR procMask = 0, sysMask = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &procMask, &sysMask);
+    std::vector<int> core(sizeof(DWORD_PTR)*8, -1), socket(sizeof(DWORD_PTR)*8, 0);
+    DWORD len = 0;
+    GetLogicalProcessorInformation(nullptr, &len);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(len / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!info.empty() && GetLogicalProcessorInformation(info.data(), &len)) {
+        int nCore = 0, nSocket = 0;
+        for (const auto& e : info) {
+            if (e.Relationship != RelationProcessorCore && e.Relationship != RelationProcessorPackage) continue;
+            const int id = (e.Relationship == RelationProcessorCore) ? nCore++ : nSocket++;
+            for (size_t b = 0; b < core.size(); ++b)
+                if (e.ProcessorMask & (DWORD_PTR(1) << b))
+                    (e.Relationship == RelationProcessorCore ? core : socket)[b] = id;
+        }
+    }
+    for (int c = 0; c < int(core.size()); ++c)
+        if (procMask & (DWORD_PTR(1) << c))
+            out.push_back({ c, core[c] >= 0 ? core[c] : c, socket[c] });
+#endif
+    return out;
+}
+
+// Agrupa las CPUs por clave (núcleo o paquete) conservando el orden de aparición de la clave
+template <class Key>
+std::vector<Place> group_by(const std::vector<Cpu>& cpus, Key key) {
+    std::vector<Place> places;
+    std::map<std::pair<int,int>, size_t> index;
+    for (const Cpu& c : cpus) {
+        const auto k = key(c);
+        auto it = index.find(k);
+        if (it == index.end()) {
+            index.emplace(k, places.size());
+            places.push_back({ c.id });
+        } else {
+            places[it->second].push_back(c.id);
+        }
+    }
+    return places;
+}
+
+// "{0,1},{2-3}" -> [[0,1],[2,3]]
+std::vector<Place> parse_places(const std::string& spec) {
+    std::vector<Place> places;
+    size_t i = 0;
+    auto fail = [&]() { throw std::runtime_error("--places invalido: " + spec); };
+    auto number = [&]() {
+        if (i >= spec.size() || spec[i] < '0' || spec[i] > '9') fail();
+        int v = 0;
+        while (i < spec.size() && spec[i] >= '0' && spec[i] <= '9') v = v*10 + (spec[i++] - '0');
+        return v;
+    };
+    while (i < spec.size()) {
+        if (spec[i] != '{') fail();
+        ++i;
+        Place p;
+        for (;;) {
+            const int a = number();
+            int b = a;
+            if (i < spec.size() && spec[i] == '-') { ++i; b = number(); }
+            if (b < a) fail();
+            for (int c = a; c <= b; ++c) p.push_back(c);
+            if (i < spec.size() && spec[i] == ',') { ++i; continue; }
+            if (i < spec.size() && spec[i] == '}') { ++i; break; }
+            fail();
+        }
+        places.push_back(p);
+        if (i < spec.size()) {
+            if (spec[i] != ',') fail();
+            ++i;
+        }
+    }
+    if (places.empty()) fail();
+    return places;
+}
+
+// Máscara del proceso tomada la primera vez, antes de atar ningún hilo
+const std::vector<Cpu>& process_cpus() {
+    static const std::vector<Cpu> cpus = allowed_cpus();
+    return cpus;
+}
+
+// Configuración activa (la escribe pin_openmp_team antes de crear otros hilos)
+std::vector<Place> g_places;
+std::string g_bind;
+
+} // namespace
+
+std::vector<Place> make_places(const std::string& spec) {
+    const std::vector<Cpu>& cpus = process_cpus();
+    std::vector<Place> places;
+    if (spec == "threads") {
+        for (const Cpu& c : cpus) places.push_back({ c.id });
+    } else if (spec == "cores") {
+        places = group_by(cpus, [](const Cpu& c) { return std::make_pair(c.socket, c.core); });
+    } else if (spec == "sockets") {
+        places = group_by(cpus, [](const Cpu& c) { return std::make_pair(c.socket, 0); });
+    } else {
+        places = parse_places(spec);
+        // Descartar CPUs no permitidas al proceso (si se conoce la máscara) y lugares vacíos
+        if (!cpus.empty()) {
+            for (Place& p : places)
+                p.erase(std::remove_if(p.begin(), p.end(), [&](int id) {
+                    return std::none_of(cpus.begin(), cpus.end(), [id](const Cpu& c) { return c.id == id; });
+                }), p.end());
+            places.erase(std::remove_if(places.begin(), places.end(), [](const Place& p) { return p.empty(); }), places.end());
+        }
+    }
+    if (places.empty()) throw std::runtime_error("--places no deja CPUs disponibles: " + spec);
+    return places;
+}
+
+int place_for_thread(int t, int T, int nPlaces, const std::string& bind) {
+    if (bind == "spread" && T <= nPlaces) return int((long long)t * nPlaces / T);
+    // close (y spread con más hilos que lugares): consecutivos, dando la vuelta
+    return t % nPlaces;
+}
+
+bool pin_current_thread(const Place& p) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : p) if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;  // 0 = hilo que llama
+#elif defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (int c : p) if (c >= 0 && c < int(sizeof(DWORD_PTR)*8)) mask |= DWORD_PTR(1) << c;
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    (void)p;
+    return false;
+#endif
+}
+
+bool unpin_current_thread() {
+    Place all;
+    for (const Cpu& c : process_cpus()) all.push_back(c.id);
+    return !all.empty() && pin_current_thread(all);
+}
+
+int pin_openmp_team(const std::vector<Place>& places, const std::string& bind) {
+    if (places.empty()) return 0;
+    process_cpus();
+    g_places = places;
+    g_bind = bind;
+    std::atomic<int> pinned{0};
+#ifdef _OPENMP
+    #pragma omp parallel
+    {
+        const int t = omp_get_thread_num(), T = omp_get_num_threads();
+        if (pin_current_thread(places[place_for_thread(t, T, int(places.size()), bind)])) ++pinned;
+    }
+#else
+    if (pin_current_thread(places[0])) ++pinned;
+#endif
+    return pinned.load();
+}
+
+bool pin_worker(int t, int T) {
+    if (g_places.empty()) return false;
+    return pin_current_thread(g_places[place_for_thread(t, T, int(g_places.size()), g_bind)]);
+}
@@ -0,0 +1,34 @@
+// src/core/affinity.hpp
+#pragma once
+#include <string>
+#include <vector>
+
+// Afinidad de hilos desde el propio programa, equivalente a OMP_PLACES / OMP_PROC_BIND.
+// Las variables de entorno se leen al iniciar el runtime (antes de main) y en MinGW rompen libgomp,
+// así que aquí cada hilo del equipo OpenMP se ata a mano a su lugar.
+
+// Un lugar = conjunto de CPUs lógicas (un elemento de OMP_PLACES)
+using Place = std::vector<int>;
+
+// Lugares para 'spec': "threads" (una CPU lógica), "cores" (CPUs que comparten núcleo),
+// "sockets" (CPUs del mismo paquete) o lista explícita "{0,1},{2,3}" / "{0-3},{4-7}".
+// Solo incluye CPUs permitidas al proceso. Lanza std::runtime_error si la lista es inválida.
+std::vector<Place> make_places(const std::string& spec);
+
+// Índice del lugar del hilo t (de T) con la política "close" (consecutivos) o "spread" (repartidos)
+int place_for_thread(int t, int T, int nPlaces, const std::string& bind);
+
+// Ata el hilo que llama a las CPUs del lugar; false si la plataforma no lo soporta o falla
+bool pin_current_thread(const Place& p);
+
+// Devuelve el hilo que llama a todas las CPUs permitidas al proceso (p. ej. el hilo del render en --async)
+bool unpin_current_thread();
+
+// Ata cada hilo de un equipo de omp_get_max_threads() hilos (los hilos del pool de OpenMP se reutilizan
+// entre regiones del mismo tamaño) y recuerda la configuración para pin_worker. Devuelve cuántos se ataron.
+int pin_openmp_team(const std::vector<Place>& places, const std::string& bind);
+
+// Ata al trabajador t de T de un pool propio (std::thread) con la última configuración de
+// pin_openmp_team; false si no hay ninguna activa. Los hilos nuevos heredan la máscara del
+// hilo que los crea (ya atado a un solo lugar), por eso cada trabajador debe atarse solo.
+bool pin_worker(int t, int T);
@@ -0,0 +1,127 @@
+// src/core/aligned_array.hpp
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Alineación de los arreglos SoA: una línea de caché y un registro AVX-512 completo
+constexpr std::size_t SIMD_ALIGN = 64;
+
+// Indica al compilador que p está alineado a SIMD_ALIGN (para cargas/stores alineados sin verificación)
+template <class T>
+inline T* assume_simd_aligned(T* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<T*>(__builtin_assume_aligned(p, SIMD_ALIGN));
+#else
+    return p;
+#endif
+}
+
+// Arreglo contiguo de tipos triviales alineado a SIMD_ALIGN y con relleno hasta un múltiplo de
+// SIMD_ALIGN bytes. Los elementos del relleno [size(), padded()) existen y valen cero, así los
+// kernels vectoriales recorren padded() elementos sin epílogo escalar.
+template <class T>
+class AlignedArray {
+    static_assert(std::is_trivially_copyable<T>::value, "AlignedArray solo admite tipos triviales");
+public:
+    // Elementos por bloque de SIMD_ALIGN bytes
+    static constexpr std::size_t LANES = SIMD_ALIGN / sizeof(T);
+
+    AlignedArray() = default;
+    explicit AlignedArray(std::size_t n) { resize(n); }
+    AlignedArray(const AlignedArray& o) { *this = o; }
+    AlignedArray(AlignedArray&& o) noexcept { swap(o); }
+    ~AlignedArray() { release(); }
+
+    // Copia sin realocar si la capacidad alcanza (caso normal: mismo N entre frames)
+    AlignedArray& operator=(const AlignedArray& o) {
+        if (this != &o) {
+            n_ = 0;  // el contenido viejo se sobrescribe: no copiarlo si hay que crecer
+            reserve_padded(o.padded());
+            n_ = o.n_;
+            if (o.padded()) std::memcpy(p_, o.p_, o.padded() * sizeof(T));
+        }
+        return *this;
+    }
+    AlignedArray& operator=(AlignedArray&& o) noexcept {
+        AlignedArray tmp(std::move(o));
+        swap(tmp);
+        return *this;
+    }
+
+    void swap(AlignedArray& o) noexcept {
+        std::swap(p_, o.p_);
+        std::swap(n_, o.n_);
+        std::swap(cap_, o.cap_);
+        std::swap(owner_, o.owner_);
+    }
+
+    // Conserva los primeros min(size, n) elementos; lo nuevo y el relleno quedan en cero
+    void resize(std::size_t n) {
+        const std::size_t keep = n < n_ ? n : n_;
+        reserve_padded(round_up(n));
+        n_ = n;
+        if (padded() > keep) std::memset(p_ + keep, 0, (padded() - keep) * sizeof(T));
+    }
+
+    // Como resize pero sin escribir la memoria nueva (ni el relleno): el llamador debe inicializar
+    // [0, padded()). Sirve para hacer el primer toque desde los hilos que usarán cada página (NUMA).
+    void allocate(std::size_t n) {
+        n_ = 0;
+        reserve_padded(round_up(n));
+        n_ = n;
+    }
+
+    // Usa memoria externa (p. ej. un archivo mapeado) sin copiarla. p debe estar alineado a SIMD_ALIGN
+    // y tener padded() elementos con el relleno inicializado; 'owner' mantiene viva esa memoria mientras
+    // el arreglo la use. Si después hay que crecer, el contenido se copia a memoria propia.
+    void adopt(T* p, std::size_t n, std::shared_ptr<void> owner) {
+        release();
+        p_ = p;
+        n_ = n;
+        cap_ = round_up(n);
+        owner_ = std::move(owner);
+    }
+
+    std::size_t size() const { return n_; }
+    // Tamaño con relleno (múltiplo de LANES)
+    std::size_t padded() const { return round_up(n_); }
+    bool empty() const { return n_ == 0; }
+
+    T* data() { return assume_simd_aligned(p_); }
+    const T* data() const { return assume_simd_aligned(p_); }
+    T& operator[](std::size_t i) { return p_[i]; }
+    const T& operator[](std::size_t i) const { return p_[i]; }
+    T* begin() { return p_; }
+    T* end() { return p_ + n_; }
+    const T* begin() const { return p_; }
+    const T* end() const { return p_ + n_; }
+
+private:
+    static std::size_t round_up(std::size_t n) { return (n + LANES - 1) / LANES * LANES; }
+
+    // Garantiza capacidad para 'cap' elementos; al crecer copia el contenido actual con su relleno
+    void reserve_padded(std::size_t cap) {
+        if (cap <= cap_) return;
+        T* p = static_cast<T*>(::operator new(cap * sizeof(T), std::align_val_t(SIMD_ALIGN)));
+        if (p_ && padded()) std::memcpy(p, p_, padded() * sizeof(T));
+        release();
+        p_ = p;
+        cap_ = cap;
+    }
+
+    void release() {
+        if (owner_) owner_.reset();
+        else if (p_) ::operator delete(p_, std::align_val_t(SIMD_ALIGN));
+        p_ = nullptr;
+        cap_ = 0;
+    }
+
+    T* p_ = nullptr;
+    std::size_t n_ = 0, cap_ = 0;
+    // Dueño de la memoria adoptada (nulo si p_ se reservó aquí)
+    std::shared_ptr<void> owner_;
+};
@@ -0,0 +1,149 @@
+// src/core/compact_state.cpp
+#include "compact_state.hpp"
+#include "physics.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define COMPACT_X86_DISPATCH 1
+    #include <immintrin.h>
+#endif
+
+// Rango de las posiciones cuantizadas: 0 = borde izquierdo/superior, POS_MAX = width/height
+static constexpr float POS_MAX = 65535.0f;
+static constexpr float VEL_MAX = 32767.0f;
+// Posición fina = (p << 8) | f, en 1/256 de paso; cabe exacta en un float (< 2^24)
+static constexpr int FRAC_BITS = 8;
+static constexpr float FINE_MAX = POS_MAX * float(1 << FRAC_BITS);
+
+void compact_pack(const State& s, CompactState& c) {
+    const int n = s.N;
+    c.width = s.width; c.height = s.height;
+    c.qx = float(s.width) / POS_MAX;
+    c.qy = float(s.height) / POS_MAX;
+    c.qv = COMPACT_VMAX / VEL_MAX;
+    c.px.resize(n); c.py.resize(n); c.fx.resize(n); c.fy.resize(n); c.vx.resize(n); c.vy.resize(n);
+    const float ix = float(1 << FRAC_BITS) / c.qx, iy = float(1 << FRAC_BITS) / c.qy, iv = 1.0f / c.qv;
+    #pragma omp parallel for if(n>65536) schedule(static)
+    for (int i=0;i<n;i++) {
+        const long qx = std::lrint(std::min(std::max(s.x[i]*ix, 0.0f), FINE_MAX));
+        const long qy = std::lrint(std::min(std::max(s.y[i]*iy, 0.0f), FINE_MAX));
+        c.px[i] = uint16_t(qx >> FRAC_BITS); c.fx[i] = uint8_t(qx);
+        c.py[i] = uint16_t(qy >> FRAC_BITS); c.fy[i] = uint8_t(qy);
+        c.vx[i] = int16_t(std::lrint(std::min(std::max(s.vx[i]*iv, -VEL_MAX), VEL_MAX)));
+        c.vy[i] = int16_t(std::lrint(std::min(std::max(s.vy[i]*iv, -VEL_MAX), VEL_MAX)));
+    }
+    c.live = true;
+}
+
+void compact_unpack(const CompactState& c, State& s) {
+    const int n = s.N;
+    const float fx = c.qx / float(1 << FRAC_BITS), fy = c.qy / float(1 << FRAC_BITS);
+    #pragma omp parallel for if(n>65536) schedule(static)
+    for (int i=0;i<n;i++) {
+        s.x[i] = float((int32_t(c.px[i]) << FRAC_BITS) | c.fx[i]) * fx;
+        s.y[i] = float((int32_t(c.py[i]) << FRAC_BITS) | c.fy[i]) * fy;
+        s.vx[i] = float(c.vx[i]) * c.qv;
+        s.vy[i] = float(c.vy[i]) * c.qv;
+    }
+}
+
+namespace {
+
+// k = desplazamiento en posición fina (1/256 de paso) por unidad de velocidad en un paso (qv*dt*256/q)
+using CompactFn = void (*)(uint16_t*, uint16_t*, uint8_t*, uint8_t*, int16_t*, int16_t*, int, float, float);
+
+// Referencia escalar: misma aritmética que la versión vectorial (float, redondeo al par más cercano)
+inline void cib_scalar_1d(uint16_t* p, uint8_t* f, int16_t* v, int i, float k) {
+    const float vel = float(v[i]);
+    const float q = float((int32_t(p[i]) << FRAC_BITS) | f[i]) + vel*k;
+    const bool out = (q < 0.f) | (q > FINE_MAX);
+    const float nv = out ? -vel : vel;
+    const int32_t fine = int32_t(std::lrint(std::min(std::max(q, 0.f), FINE_MAX)));
+    p[i] = uint16_t(fine >> FRAC_BITS);
+    f[i] = uint8_t(fine);
+    v[i] = int16_t(std::min(std::max(nv, -32768.0f), VEL_MAX));
+}
+
+void cib_scalar(uint16_t* px, uint16_t* py, uint8_t* fx, uint8_t* fy, int16_t* vx, int16_t* vy, int n, float kx, float ky) {
+    for (int i=0;i<n;i++) {
+        cib_scalar_1d(px, fx, vx, i, kx);
+        cib_scalar_1d(py, fy, vy, i, ky);
+    }
+}
+
+#ifdef COMPACT_X86_DISPATCH
+// 8 carriles: posición fina (p << 8 | f) y velocidad -> float, integrar, rebotar y redondear de vuelta
+__attribute__((target("avx2")))
+inline void cib_avx2_8(__m128i p16, __m128i f8, __m128i v16, __m256 k, __m256i& fineOut, __m256i& vOut) {
+    const __m256 zero = _mm256_setzero_ps(), lim = _mm256_set1_ps(FINE_MAX);
+    const __m256i fine = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvtepu16_epi32(p16), FRAC_BITS), _mm256_cvtepu8_epi32(f8));
+    const __m256 p = _mm256_cvtepi32_ps(fine);
+    __m256 v = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v16));
+    __m256 q = _mm256_add_ps(p, _mm256_mul_ps(v, k));
+    const __m256 out = _mm256_or_ps(_mm256_cmp_ps(q, zero, _CMP_LT_OQ), _mm256_cmp_ps(q, lim, _CMP_GT_OQ));
+    v = _mm256_blendv_ps(v, _mm256_sub_ps(zero, v), out);
+    q = _mm256_min_ps(_mm256_max_ps(q, zero), lim);
+    fineOut = _mm256_cvtps_epi32(q);
+    vOut = _mm256_cvtps_epi32(v);
+}
+
+__attribute__((target("avx2")))
+void cib_avx2(uint16_t* px, uint16_t* py, uint8_t* fx, uint8_t* fy, int16_t* vx, int16_t* vy, int n, float kx, float ky) {
+    const __m256 k[2] = { _mm256_set1_ps(kx), _mm256_set1_ps(ky) };
+    const __m256i lowByte = _mm256_set1_epi32(0xFF);
+    uint16_t* P[2] = { px, py };
+    uint8_t* F[2] = { fx, fy };
+    int16_t* V[2] = { vx, vy };
+    for (int i=0; i<n; i+=16) {
+        for (int a=0;a<2;a++) {
+            const __m256i p16 = _mm256_load_si256(reinterpret_cast<const __m256i*>(P[a]+i));
+            const __m128i f8 = _mm_load_si128(reinterpret_cast<const __m128i*>(F[a]+i));
+            const __m256i v16 = _mm256_load_si256(reinterpret_cast<const __m256i*>(V[a]+i));
+            __m256i qLo, vLo, qHi, vHi;
+            cib_avx2_8(_mm256_castsi256_si128(p16), f8, _mm256_castsi256_si128(v16), k[a], qLo, vLo);
+            cib_avx2_8(_mm256_extracti128_si256(p16, 1), _mm_srli_si128(f8, 8), _mm256_extracti128_si256(v16, 1), k[a], qHi, vHi);
+            // pack satura a 16 bits pero intercala las mitades de 128 bits: permute para el orden original
+            const __m256i pp = _mm256_permute4x64_epi64(
+                _mm256_packus_epi32(_mm256_srli_epi32(qLo, FRAC_BITS), _mm256_srli_epi32(qHi, FRAC_BITS)), 0xD8);
+            const __m256i ff = _mm256_permute4x64_epi64(
+                _mm256_packus_epi32(_mm256_and_si256(qLo, lowByte), _mm256_and_si256(qHi, lowByte)), 0xD8);
+            const __m256i vv = _mm256_permute4x64_epi64(_mm256_packs_epi32(vLo, vHi), 0xD8);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(P[a]+i), pp);
+            _mm_store_si128(reinterpret_cast<__m128i*>(F[a]+i),
+                            _mm_packus_epi16(_mm256_castsi256_si128(ff), _mm256_extracti128_si256(ff, 1)));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(V[a]+i), vv);
+        }
+    }
+}
+#endif // COMPACT_X86_DISPATCH
+
+struct Dispatch { CompactFn fn; const char* name; };
+
+const Dispatch& dispatch() {
+    static const Dispatch d = []() -> Dispatch {
+#ifdef COMPACT_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return { cib_avx2, "avx2" };
+#endif
+        return { cib_scalar, "scalar" };
+    }();
+    return d;
+}
+
+} // namespace
+
+void compact_integrate_bounce(CompactState& c, int n, float dt, int begin, int end) {
+    // Igual que integrate_bounce: el último bloque llega al relleno (en cero, queda quieto)
+    if (end == n) end = int(c.px.padded());
+    if (end <= begin) return;
+    const float kx = c.qv * dt * float(1 << FRAC_BITS) / c.qx, ky = c.qv * dt * float(1 << FRAC_BITS) / c.qy;
+    const bool full = begin % FLOAT_LANES == 0 && (end - begin) % FLOAT_LANES == 0;
+    const CompactFn fn = full ? dispatch().fn : cib_scalar;
+    fn(c.px.data()+begin, c.py.data()+begin, c.fx.data()+begin, c.fy.data()+begin,
+       c.vx.data()+begin, c.vy.data()+begin, end-begin, kx, ky);
+}
+
+const char* compact_integrate_bounce_isa() {
+    return dispatch().name;
+}
@@ -0,0 +1,32 @@
+// src/core/compact_state.hpp
+#pragma once
+#include <cstdint>
+#include "state.hpp"
+
+// Almacenamiento compacto de posición y velocidad para N muy grandes (10 bytes por partícula en
+// lugar de 16). Posiciones en punto fijo sin signo de 16 bits relativas a la caja width x height
+// (paso ~0.02 px en 1280x720) más un acumulador de 8 bits con la fracción de paso (1/256), para que las
+// velocidades chicas avancen y el desplazamiento por paso no se redondee a pasos enteros. Velocidades
+// en punto fijo con signo de 16 bits en +-COMPACT_VMAX px/s.
+constexpr float COMPACT_VMAX = 1024.0f;
+
+struct CompactState {
+    AlignedArray<uint16_t> px, py;
+    AlignedArray<uint8_t> fx, fy;   // fracción de paso de posición (1/256), debajo de px/py
+    AlignedArray<int16_t> vx, vy;
+    // Tamaño de un paso de cuantización (px y px/s)
+    float qx = 1.0f, qy = 1.0f, qv = 1.0f;
+    int width = 0, height = 0;
+    // true si estos arreglos son la copia vigente (las posiciones/velocidades float de State pueden estar atrasadas)
+    bool live = false;
+};
+
+// Cuantiza posiciones y velocidades de s (redondeo al más cercano, con saturación) y marca live
+void compact_pack(const State& s, CompactState& c);
+// Reconstruye x, y, vx, vy de s desde la copia compacta (no cambia live)
+void compact_unpack(const CompactState& c, State& s);
+// Integra y rebota [begin, end) directamente en punto fijo (SIMD con despacho por ISA).
+// Mismo contrato de bloques que integrate_bounce: begin múltiplo de FLOAT_LANES; end == N llega al relleno.
+void compact_integrate_bounce(CompactState& c, int n, float dt, int begin, int end);
+// Nombre del ISA elegido para el kernel compacto: "avx2" o "scalar"
+const char* compact_integrate_bounce_isa();
@@ -1,7 +1,11 @@
 // src/core/grid.cpp
 #include "grid.hpp"
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
 
 // Construir la Grid
 Grid::Grid(int width, int height, int wantedCells) {
@@ -11,18 +15,149 @@ Grid::Grid(int width, int height, int wantedCells) {
     cellH = height / float(rows);
 }
 
+// Ajuste de resolucion: lado de celda = max(minCell, sqrt(area*objetivo/N)), asi el numero de
+// vecinos por particula se mantiene casi constante con cualquier N y cualquier ventana
+bool Grid::fit(int width, int height, int n, float minCell) {
+    if (width == fitWidth && height == fitHeight && n == fitN && minCell == fitMinCell) return false;
+    fitWidth = width; fitHeight = height; fitN = n; fitMinCell = minCell;
+    const float area = float(width) * float(height);
+    float side = std::sqrt(area * TARGET_PER_CELL / float(std::max(n, 1)));
+    side = std::max(side, minCell);
+    // Limitar el numero de celdas (ventanas enormes con minCell muy chico)
+    const float maxCells = float(1 << 22);
+    if (area / (side*side) > maxCells) side = std::sqrt(area / maxCells);
+    tile(width, height, side);
+    return true;
+}
+
+void Grid::tile(int width, int height, float side) {
+    // Celdas cuadradas; la ultima fila/columna puede salir del area (cellIndex acota)
+    cols = std::max(1, int(std::ceil(width / side)));
+    rows = std::max(1, int(std::ceil(height / side)));
+    cellW = cellH = side;
+    invalidate();
+}
+
 // Construccion de la estructura del Grid
 void Grid::build(const State& s) {
-    // Inicializar las estructuras
+    // Inicializar las estructuras (sin realocar si el tamaño no cambia)
     head.assign(cols*rows, -1);
     next.assign(s.N, -1);
+    prev.assign(s.N, -1);
+    cellOf.resize(s.N);
     // Insertar cada particula en su celda que le corresponde
     for (int i=0;i<s.N;i++) {
-        int cx = std::min(cols-1, std::max(0, int(s.x[i] / cellW)));
-        int cy = std::min(rows-1, std::max(0, int(s.y[i] / cellH)));
-        int idx = cy*cols + cx;
+        int idx = cellIndex(s.x[i], s.y[i]);
+        cellOf[i] = idx;
         // Inserta al inicio de la lista de esa celda
         next[i] = head[idx];
+        if (head[idx] != -1) prev[head[idx]] = i;
         head[idx] = i;
     }
-}
\ No newline at end of file
+}
+
+// Actualizacion incremental: solo mueve las particulas que cruzaron de celda
+void Grid::update(const State& s) {
+    if (int(cellOf.size()) != s.N || int(head.size()) != cols*rows) {
+        build(s);
+        return;
+    }
+    for (int i=0;i<s.N;i++) {
+        int idx = cellIndex(s.x[i], s.y[i]);
+        int old = cellOf[i];
+        if (idx == old) continue;
+        // Desenlazar de la celda anterior
+        if (prev[i] != -1) next[prev[i]] = next[i];
+        else head[old] = next[i];
+        if (next[i] != -1) prev[next[i]] = prev[i];
+        // Enlazar al inicio de la nueva celda
+        prev[i] = -1;
+        next[i] = head[idx];
+        if (head[idx] != -1) prev[head[idx]] = i;
+        head[idx] = i;
+        cellOf[i] = idx;
+    }
+}
+
+// Construccion CSR en paralelo (ordenamiento por conteo)
+void Grid::buildSorted(const State& s) {
+    #pragma omp parallel if(s.N>4096)
+    buildSortedTeam(s);
+}
+
+// Fases del build CSR. La parte 'part' de 'parts' procesa siempre el mismo bloque contiguo de
+// particulas en el histograma y en el scatter, asi el orden dentro de cada celda es estable
+// e independiente del numero de partes.
+void Grid::csrPrepare(const State& s, int parts) {
+    const int cells = cols*rows;
+    cellStart.resize(cells+1);
+    cellCount.resize(cells);
+    sorted.resize(s.N);
+    cellKey.resize(s.N);
+    hist.resize(size_t(parts)*cells);
+}
+
+// 1) Histograma local de la parte
+void Grid::csrHistogram(const State& s, int part, int parts) {
+    const int cells = cols*rows;
+    int* h = hist.data() + size_t(part)*cells;
+    std::fill(h, h+cells, 0);
+    const int b = int(int64_t(s.N)*part/parts), e = int(int64_t(s.N)*(part+1)/parts);
+    for (int i=b;i<e;i++) {
+        int idx = cellIndex(s.x[i], s.y[i]);
+        cellKey[i] = idx;
+        h[idx]++;
+    }
+}
+
+// 2) Por celda en [cBegin, cEnd): total y desplazamiento de cada parte dentro de la celda
+void Grid::csrOffsets(int cBegin, int cEnd, int parts) {
+    const int cells = cols*rows;
+    for (int c=cBegin;c<cEnd;c++) {
+        int sum = 0;
+        for (int k=0;k<parts;k++) {
+            int v = hist[size_t(k)*cells + c];
+            hist[size_t(k)*cells + c] = sum;
+            sum += v;
+        }
+        cellCount[c] = sum;
+    }
+}
+
+// 3) Prefix sum exclusivo sobre las celdas
+void Grid::csrPrefix() {
+    const int cells = cols*rows;
+    cellStart[0] = 0;
+    for (int c=0;c<cells;c++) cellStart[c+1] = cellStart[c] + cellCount[c];
+}
+
+// 4) Scatter de la parte al indice ordenado
+void Grid::csrScatter(const State& s, int part, int parts) {
+    const int cells = cols*rows;
+    int* h = hist.data() + size_t(part)*cells;
+    const int b = int(int64_t(s.N)*part/parts), e = int(int64_t(s.N)*(part+1)/parts);
+    for (int i=b;i<e;i++) {
+        int idx = cellKey[i];
+        sorted[cellStart[idx] + h[idx]++] = i;
+    }
+}
+
+// Cada hilo del equipo es una parte
+void Grid::buildSortedTeam(const State& s) {
+    const int cells = cols*rows;
+#ifdef _OPENMP
+    const int T = omp_get_num_threads(), t = omp_get_thread_num();
+#else
+    const int T = 1, t = 0;
+#endif
+    #pragma omp single
+    csrPrepare(s, T);
+    csrHistogram(s, t, T);
+    #pragma omp barrier
+    csrOffsets(int(int64_t(cells)*t/T), int(int64_t(cells)*(t+1)/T), T);
+    #pragma omp barrier
+    #pragma omp single
+    csrPrefix();
+    csrScatter(s, t, T);
+    #pragma omp barrier
+}
@@ -11,8 +11,51 @@ struct Grid {
     float cellW, cellH;
     // Indice del primer elemento en cada celda y el siguiente elemento en la lista
     std::vector<int> head, next; 
-    // Construir el grid
+    // Elemento anterior en la lista (para desenlazar en O(1)) y celda actual de cada particula
+    std::vector<int> prev, cellOf;
+    // Layout CSR: las particulas de la celda c son sorted[cellStart[c] .. cellStart[c]+cellCount[c])
+    std::vector<int> cellStart, cellCount, sorted;
+    // Celda de cada particula e histogramas por hilo usados por buildSorted
+    std::vector<int> cellKey, hist;
+    // Particulas por celda buscadas al ajustar la resolucion (fit)
+    static constexpr float TARGET_PER_CELL = 4.0f;
+    // Parametros con los que se ajusto la resolucion por ultima vez
+    int fitWidth = 0, fitHeight = 0, fitN = -1;
+    float fitMinCell = 0.0f;
+    // Construir el grid con wantedCells x wantedCells celdas (fit la reajusta despues)
     explicit Grid(int width, int height, int wantedCells=64);
+    // Elige celdas cuadradas a partir de la densidad (~TARGET_PER_CELL particulas por celda) sin bajar
+    // de minCell (diametro de interaccion). Solo recalcula si cambio N o el area; devuelve true en ese caso
+    // e invalida el grid incremental.
+    bool fit(int width, int height, int n, float minCell);
+    // Celdas cuadradas de lado fijo 'side' que cubren width x height (p. ej. tiles de pantalla)
+    void tile(int width, int height, float side);
     // Llena el grid con las particulas del estado actual
     void build(const State& s);
+    // Actualiza el grid reenlazando solo las particulas que cambiaron de celda desde el ultimo frame.
+    // Si el numero de particulas cambio (o nunca se construyo) hace un build completo.
+    void update(const State& s);
+    // Construye el layout CSR con histograma paralelo, prefix sum y scatter (abre su propia region paralela)
+    void buildSorted(const State& s);
+    // Igual que buildSorted pero debe llamarse por todos los hilos de una region paralela ya abierta.
+    // Empieza con una barrera (single) y termina con otra, asi que puede ir justo despues de un
+    // 'omp for nowait' que escribe posiciones y lo que sigue puede leer el grid sin otra barrera.
+    void buildSortedTeam(const State& s);
+    // Fases del build CSR para cualquier planificador (OpenMP, pool propio...). Orden:
+    // csrPrepare; csrHistogram por parte; csrOffsets por rango de celdas; csrPrefix; csrScatter por parte.
+    // Cada fase debe terminar en todas las partes antes de empezar la siguiente.
+    void csrPrepare(const State& s, int parts);
+    void csrHistogram(const State& s, int part, int parts);
+    void csrOffsets(int cBegin, int cEnd, int parts);
+    void csrPrefix();
+    void csrScatter(const State& s, int part, int parts);
+    // Fuerza a que el siguiente update haga un build completo
+    void invalidate() { cellOf.clear(); }
+    // Indice de la celda que contiene el punto (x, y), acotado a los bordes
+    inline int cellIndex(float x, float y) const {
+        int cx = int(x / cellW), cy = int(y / cellH);
+        cx = cx < 0 ? 0 : (cx > cols-1 ? cols-1 : cx);
+        cy = cy < 0 ? 0 : (cy > rows-1 ? rows-1 : cy);
+        return cy*cols + cx;
+    }
 };
@@ -1,23 +1,88 @@
 // src/core/physics.cpp
 #include "physics.hpp"
 #include <algorithm>
+#include <cmath>
 
 // Actualiza posiciones con integración
 void integrate(State& s, float dt) {
-    // Actualiza las posiciones de las partículas
-    for (int i=0;i<s.N;i++) {
-        s.x[i] += s.vx[i] * dt;
-        s.y[i] += s.vy[i] * dt;
+    // Recorre hasta el relleno (múltiplo de FLOAT_LANES) con punteros alineados: sin epílogo
+    float* x = s.x.data(); float* y = s.y.data();
+    const float* vx = s.vx.data(); const float* vy = s.vy.data();
+    const int n = int(s.x.padded());
+    for (int i=0;i<n;i++) {
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
     }
 }
 
 // Rebota las partículas al chocar con los bordes del área
 void bounce(State& s) {
-    // Rebotar en los bordes
-    for (int i=0;i<s.N;i++) {
-        if (s.x[i] < 0.f) { s.x[i]=0.f; s.vx[i] = -s.vx[i]; }
-        if (s.x[i] > s.width) { s.x[i]=float(s.width); s.vx[i] = -s.vx[i]; }
-        if (s.y[i] < 0.f) { s.y[i]=0.f; s.vy[i] = -s.vy[i]; }
-        if (s.y[i] > s.height){ s.y[i]=float(s.height); s.vy[i] = -s.vy[i]; }
+    // Rebotar en los bordes (el relleno en cero nunca rebota)
+    float* x = s.x.data(); float* y = s.y.data();
+    float* vx = s.vx.data(); float* vy = s.vy.data();
+    const int n = int(s.x.padded());
+    for (int i=0;i<n;i++) {
+        if (x[i] < 0.f) { x[i]=0.f; vx[i] = -vx[i]; }
+        if (x[i] > s.width) { x[i]=float(s.width); vx[i] = -vx[i]; }
+        if (y[i] < 0.f) { y[i]=0.f; vy[i] = -vy[i]; }
+        if (y[i] > s.height){ y[i]=float(s.height); vy[i] = -vy[i]; }
     }
-}
\ No newline at end of file
+}
+
+// Interpolación lineal de posiciones para el render (no reserva memoria si out ya tiene tamaño N)
+void interpolate_state(const State& prev, const State& cur, float alpha, State& out, bool curChanged) {
+    out.N = cur.N; out.width = cur.width; out.height = cur.height;
+    out.x.resize(cur.N); out.y.resize(cur.N);
+    for (int i=0;i<cur.N;i++) {
+        out.x[i] = prev.x[i] + (cur.x[i] - prev.x[i]) * alpha;
+        out.y[i] = prev.y[i] + (cur.y[i] - prev.y[i]) * alpha;
+    }
+    // Entre dos pasos solo cambia alpha: vx, vy, color e id de out siguen siendo los de cur
+    if (!curChanged) return;
+    out.vx = cur.vx; out.vy = cur.vy;
+    out.color = cur.color; out.id = cur.id;
+}
+
+// Colisión elástica entre dos partículas de igual masa (i, j)
+static inline void resolve_pair(State& s, int i, int j, float diam) {
+    float dx = s.x[j] - s.x[i], dy = s.y[j] - s.y[i];
+    float d2 = dx*dx + dy*dy;
+    if (d2 >= diam*diam || d2 <= 1e-12f) return;
+    float d = std::sqrt(d2);
+    float nx = dx / d, ny = dy / d;
+    // Separar las partículas la mitad del traslape cada una
+    float push = 0.5f * (diam - d);
+    s.x[i] -= nx*push; s.y[i] -= ny*push;
+    s.x[j] += nx*push; s.y[j] += ny*push;
+    // Velocidad relativa sobre la normal; si se acercan, intercambian componente normal
+    float vn = (s.vx[j] - s.vx[i])*nx + (s.vy[j] - s.vy[i])*ny;
+    if (vn < 0.f) {
+        s.vx[i] += vn*nx; s.vy[i] += vn*ny;
+        s.vx[j] -= vn*nx; s.vy[j] -= vn*ny;
+    }
+}
+
+// Recorre la celda (cx,cy) y su media vecindad para que cada par se visite una sola vez.
+// Usa el layout CSR del Grid (buildSorted), así que cada celda es un rango contiguo de sorted.
+void collide_cell(State& s, const Grid& g, int cx, int cy, float radius) {
+    static const int off[4][2] = { {1,0}, {-1,1}, {0,1}, {1,1} };
+    const float diam = 2.f * radius;
+    const int c = cy*g.cols + cx;
+    const int* cell = g.sorted.data() + g.cellStart[c];
+    const int n = g.cellCount[c];
+    for (int a = 0; a < n; ++a) {
+        const int i = cell[a];
+        // Pares dentro de la misma celda
+        for (int b = a+1; b < n; ++b)
+            resolve_pair(s, i, cell[b], diam);
+        // Pares con las celdas vecinas hacia adelante
+        for (const auto& o : off) {
+            int nx = cx + o[0], ny = cy + o[1];
+            if (nx < 0 || nx >= g.cols || ny >= g.rows) continue;
+            const int nc = ny*g.cols + nx;
+            const int* other = g.sorted.data() + g.cellStart[nc];
+            for (int b = 0, m = g.cellCount[nc]; b < m; ++b)
+                resolve_pair(s, i, other[b], diam);
+        }
+    }
+}
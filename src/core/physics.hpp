@@ -1,8 +1,36 @@
 // src/core/physics.hpp
 #pragma once
 #include "state.hpp"
+#include "grid.hpp"
+
+// Radio de colisión de cada partícula (px). Las celdas del Grid deben medir al menos 2*radio.
+constexpr float PARTICLE_RADIUS = 3.0f;
+
+// Ajusta la resolución del grid a la densidad del estado (celdas cuadradas de al menos 2*radio).
+// Barato si no cambió N ni el área: los backends lo llaman al inicio de cada paso.
+inline bool fit_grid(Grid& g, const State& s) {
+    return g.fit(s.width, s.height, s.N, 2.0f*PARTICLE_RADIUS);
+}
 
 // Actualizar el estado con integración
 void integrate(State& s, float dt);
 // Aplicar rebote a un estado 
 void bounce(State& s);
+// Estado para dibujar entre dos pasos fijos: posiciones prev + (cur - prev)*alpha, el resto copiado de cur.
+// prev y cur deben tener las partículas en el mismo orden (sin reordenamiento Morton entre ambos).
+// Con curChanged = false solo recalcula x e y: out ya tiene el resto de este mismo cur.
+void interpolate_state(const State& prev, const State& cur, float alpha, State& out, bool curChanged = true);
+// Integrar y rebotar en una sola pasada sobre [begin, end) (kernel SIMD con despacho por ISA).
+// begin debe ser múltiplo de FLOAT_LANES; si end == N el kernel sigue hasta el relleno del State,
+// así todos los bloques son de vectores completos y alineados (otros rangos usan la versión escalar).
+void integrate_bounce(State& s, float dt, int begin, int end);
+// Nombre del ISA elegido en tiempo de ejecución: "avx512", "avx2", "sse2" o "scalar"
+const char* integrate_bounce_isa();
+// Floats por bloque alineado de los arreglos del State (16 = un registro AVX-512)
+constexpr int FLOAT_LANES = int(AlignedArray<float>::LANES);
+// Tamaño de bloque con el que los backends OpenMP reparten el kernel fusionado
+constexpr int KERNEL_BLOCK = 128;
+static_assert(KERNEL_BLOCK % FLOAT_LANES == 0, "los bloques deben empezar alineados");
+// Resolver colisiones elásticas de la celda (cx,cy) contra sí misma y su media vecindad
+// (E, SO, S, SE). Requiere g.buildSorted(). Solo escribe en las columnas cx-1..cx+1 y filas cy..cy+1.
+void collide_cell(State& s, const Grid& g, int cx, int cy, float radius);
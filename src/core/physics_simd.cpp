@@ -0,0 +1,126 @@
+// src/core/physics_simd.cpp
+// Kernel fusionado integrar + rebotar con despacho en tiempo de ejecución según el ISA del CPU.
+#include "physics.hpp"
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define PHYS_X86_DISPATCH 1
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+// Las versiones vectoriales reciben punteros alineados a SIMD_ALIGN y n múltiplo de FLOAT_LANES
+// (bloques completos del State con relleno): cargas/stores alineados y sin epílogo escalar.
+using KernelFn = void (*)(float*, float*, float*, float*, int, float, float, float);
+
+// Versión escalar sin saltos: clamp con min/max y reflexión por selección.
+// Es la referencia para las versiones vectoriales y cubre los rangos no alineados.
+inline void ib_scalar_1d(float* p, float* v, int i, float dt, float lim) {
+    float q = p[i] + v[i]*dt;
+    bool out = (q < 0.f) | (q > lim);
+    v[i] = out ? -v[i] : v[i];
+    p[i] = std::min(std::max(q, 0.f), lim);
+}
+
+void ib_scalar(float* x, float* y, float* vx, float* vy, int n, float dt, float w, float h) {
+    for (int i=0;i<n;i++) {
+        ib_scalar_1d(x, vx, i, dt, w);
+        ib_scalar_1d(y, vy, i, dt, h);
+    }
+}
+
+#ifdef PHYS_X86_DISPATCH
+__attribute__((target("sse2")))
+void ib_sse2(float* x, float* y, float* vx, float* vy, int n, float dt, float w, float h) {
+    const __m128 vdt = _mm_set1_ps(dt), zero = _mm_setzero_ps(), sign = _mm_set1_ps(-0.0f);
+    const __m128 lim[2] = { _mm_set1_ps(w), _mm_set1_ps(h) };
+    float* P[2] = { x, y };
+    float* V[2] = { vx, vy };
+    for (int i=0; i<n; i+=4) {
+        for (int a=0;a<2;a++) {
+            __m128 p = _mm_load_ps(P[a]+i), v = _mm_load_ps(V[a]+i);
+            p = _mm_add_ps(p, _mm_mul_ps(v, vdt));
+            __m128 out = _mm_or_ps(_mm_cmplt_ps(p, zero), _mm_cmpgt_ps(p, lim[a]));
+            v = _mm_xor_ps(v, _mm_and_ps(out, sign));
+            p = _mm_min_ps(_mm_max_ps(p, zero), lim[a]);
+            _mm_store_ps(P[a]+i, p);
+            _mm_store_ps(V[a]+i, v);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void ib_avx2(float* x, float* y, float* vx, float* vy, int n, float dt, float w, float h) {
+    const __m256 vdt = _mm256_set1_ps(dt), zero = _mm256_setzero_ps();
+    const __m256 lim[2] = { _mm256_set1_ps(w), _mm256_set1_ps(h) };
+    float* P[2] = { x, y };
+    float* V[2] = { vx, vy };
+    for (int i=0; i<n; i+=8) {
+        for (int a=0;a<2;a++) {
+            __m256 p = _mm256_load_ps(P[a]+i), v = _mm256_load_ps(V[a]+i);
+            p = _mm256_add_ps(p, _mm256_mul_ps(v, vdt));
+            __m256 out = _mm256_or_ps(_mm256_cmp_ps(p, zero, _CMP_LT_OQ), _mm256_cmp_ps(p, lim[a], _CMP_GT_OQ));
+            v = _mm256_blendv_ps(v, _mm256_sub_ps(zero, v), out);
+            p = _mm256_min_ps(_mm256_max_ps(p, zero), lim[a]);
+            _mm256_store_ps(P[a]+i, p);
+            _mm256_store_ps(V[a]+i, v);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+void ib_avx512(float* x, float* y, float* vx, float* vy, int n, float dt, float w, float h) {
+    const __m512 vdt = _mm512_set1_ps(dt), zero = _mm512_setzero_ps();
+    const __m512 lim[2] = { _mm512_set1_ps(w), _mm512_set1_ps(h) };
+    const __mmask16 all = 0xFFFF;
+    float* P[2] = { x, y };
+    float* V[2] = { vx, vy };
+    for (int i=0; i<n; i+=16) {
+        for (int a=0;a<2;a++) {
+            __m512 p = _mm512_load_ps(P[a]+i), v = _mm512_load_ps(V[a]+i);
+            p = _mm512_add_ps(p, _mm512_mul_ps(v, vdt));
+            __mmask16 out = _mm512_cmp_ps_mask(p, zero, _CMP_LT_OQ) | _mm512_cmp_ps_mask(p, lim[a], _CMP_GT_OQ);
+            v = _mm512_mask_sub_ps(v, out, zero, v);
+            // maskz con todos los carriles: igual a min/max pero evita un falso
+            // -Wmaybe-uninitialized de GCC 12 dentro de _mm512_undefined_ps()
+            p = _mm512_maskz_min_ps(all, _mm512_maskz_max_ps(all, p, zero), lim[a]);
+            _mm512_store_ps(P[a]+i, p);
+            _mm512_store_ps(V[a]+i, v);
+        }
+    }
+}
+#endif // PHYS_X86_DISPATCH
+
+struct Dispatch { KernelFn fn; const char* name; };
+
+// Se resuelve una sola vez (static local, inicialización segura entre hilos)
+const Dispatch& dispatch() {
+    static const Dispatch d = []() -> Dispatch {
+#ifdef PHYS_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return { ib_avx512, "avx512" };
+        if (__builtin_cpu_supports("avx2"))    return { ib_avx2, "avx2" };
+        if (__builtin_cpu_supports("sse2"))    return { ib_sse2, "sse2" };
+#endif
+        return { ib_scalar, "scalar" };
+    }();
+    return d;
+}
+
+} // namespace
+
+// Integra y rebota las partículas [begin, end) en una sola pasada
+void integrate_bounce(State& s, float dt, int begin, int end) {
+    // El último bloque llega hasta el relleno (en cero: queda quieto en el origen)
+    if (end == s.N) end = int(s.x.padded());
+    if (end <= begin) return;
+    const bool full = begin % FLOAT_LANES == 0 && (end - begin) % FLOAT_LANES == 0;
+    const KernelFn fn = full ? dispatch().fn : ib_scalar;
+    fn(s.x.data()+begin, s.y.data()+begin, s.vx.data()+begin, s.vy.data()+begin,
+       end-begin, dt, float(s.width), float(s.height));
+}
+
+const char* integrate_bounce_isa() {
+    return dispatch().name;
+}
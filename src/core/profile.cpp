@@ -0,0 +1,112 @@
+// src/core/profile.cpp
+#include "profile.hpp"
+
+#ifdef PROFILING_ENABLED
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define PROF_HAS_TSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #include <x86intrin.h>
+    #define PROF_HAS_TSC 1
+#endif
+
+namespace prof {
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t t0, t1;
+};
+
+// Ring buffer por hilo: al llenarse sobrescribe los eventos más viejos
+struct ThreadBuffer {
+    static constexpr size_t CAPACITY = size_t(1) << 17;
+    std::vector<Event> events;
+    uint64_t written = 0;
+    int tid = 0;
+    ThreadBuffer() : events(CAPACITY) {}
+};
+
+struct Registry {
+    std::mutex mtx;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    // Punto de calibración ticks <-> tiempo real
+    uint64_t tick0 = now();
+    std::chrono::steady_clock::time_point wall0 = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+ThreadBuffer& local_buffer() {
+    thread_local ThreadBuffer* tb = [] {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mtx);
+        r.buffers.push_back(std::make_unique<ThreadBuffer>());
+        r.buffers.back()->tid = int(r.buffers.size()) - 1;
+        return r.buffers.back().get();
+    }();
+    return *tb;
+}
+
+// Fija el punto de calibración al iniciar el programa, antes de cualquier zona
+Registry& g_registry_init = registry();
+
+} // namespace
+
+uint64_t now() {
+#ifdef PROF_HAS_TSC
+    return __rdtsc();
+#else
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+void record(const char* name, uint64_t t0, uint64_t t1) {
+    ThreadBuffer& tb = local_buffer();
+    tb.events[tb.written % ThreadBuffer::CAPACITY] = { name, t0, t1 };
+    ++tb.written;
+}
+
+bool write_chrome_trace(const char* path) {
+    Registry& r = registry();
+    // Ticks por microsegundo medidos entre el primer uso y ahora
+    const uint64_t tick1 = now();
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - r.wall0).count();
+    const double ticksPerUs = (us > 0.0 && tick1 > r.tick0) ? double(tick1 - r.tick0) / us : 1000.0;
+
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", f);
+    bool first = true;
+    std::lock_guard<std::mutex> lock(r.mtx);
+    for (const auto& tb : r.buffers) {
+        std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+                     first ? "" : ",\n", tb->tid, tb->tid);
+        first = false;
+        const uint64_t n = tb->written < ThreadBuffer::CAPACITY ? tb->written : ThreadBuffer::CAPACITY;
+        for (uint64_t k = tb->written - n; k < tb->written; ++k) {
+            const Event& e = tb->events[k % ThreadBuffer::CAPACITY];
+            if (e.t0 < r.tick0) continue;
+            std::fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         e.name, tb->tid, double(e.t0 - r.tick0) / ticksPerUs, double(e.t1 - e.t0) / ticksPerUs);
+        }
+    }
+    std::fputs("\n]}\n", f);
+    std::fclose(f);
+    return true;
+}
+
+} // namespace prof
+
+#endif // PROFILING_ENABLED
@@ -0,0 +1,46 @@
+// src/core/profile.hpp
+#pragma once
+// Capa de perfilado de bajo costo. Se activa en compilación con -DENABLE_PROFILING=ON (define PROFILING_ENABLED);
+// sin ella las macros no generan código.
+//
+//   PROF_ZONE("grid");          // mide desde aquí hasta el fin del bloque
+//   PROF_BARRIER("barrier");    // barrera OpenMP medida (solo al final de una región paralela)
+//
+// Cada hilo escribe en su propio ring buffer (sin locks); prof::write_chrome_trace exporta todo
+// en formato Chrome trace / Perfetto (chrome://tracing, ui.perfetto.dev).
+
+#ifdef PROFILING_ENABLED
+#include <cstdint>
+
+namespace prof {
+
+// Marca de tiempo en ticks (RDTSC en x86, steady_clock en otros)
+uint64_t now();
+// Registra una zona [t0, t1) en el buffer del hilo actual
+void record(const char* name, uint64_t t0, uint64_t t1);
+// Escribe todas las zonas registradas; false si no se pudo abrir el archivo
+bool write_chrome_trace(const char* path);
+
+struct Zone {
+    const char* name;
+    uint64_t t0;
+    explicit Zone(const char* n) : name(n), t0(now()) {}
+    ~Zone() { record(name, t0, now()); }
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+};
+
+} // namespace prof
+
+#define PROF_CONCAT_(a, b) a##b
+#define PROF_CONCAT(a, b) PROF_CONCAT_(a, b)
+#define PROF_ZONE(name) ::prof::Zone PROF_CONCAT(prof_zone_, __LINE__)(name)
+#define PROF_BARRIER(name) do { ::prof::Zone prof_barrier_(name); _Pragma("omp barrier") } while (0)
+
+#else
+
+#define PROF_ZONE(name) ((void)0)
+// Sin perfilado basta la barrera implícita al final de la región
+#define PROF_BARRIER(name) ((void)0)
+
+#endif
@@ -0,0 +1,48 @@
+// src/core/reorder.cpp
+#include "reorder.hpp"
+#include <algorithm>
+
+// Permuta un arreglo usando un buffer temporal y lo intercambia (sin copia de vuelta)
+template <class T>
+static void permute(AlignedArray<T>& a, AlignedArray<T>& tmp, const vector<uint64_t>& keys, int n) {
+    tmp.resize(n);
+    #pragma omp parallel for if(n>16384) schedule(static)
+    for (int k=0;k<n;k++) tmp[k] = a[uint32_t(keys[k])];
+    a.swap(tmp);
+}
+
+void reorder_morton(State& s, SimContext& ctx) {
+    // Si el backend compacto lleva la copia vigente, bajarla al State antes de permutar;
+    // el siguiente paso vuelve a cuantizar en el orden nuevo
+    if (ctx.compact.live) {
+        compact_unpack(ctx.compact, s);
+        ctx.compact.live = false;
+    }
+    const Grid& g = ctx.grid;
+    const int n = s.N;
+    // Clave = (morton de la celda << 32) | índice actual, así el sort es estable
+    auto& keys = ctx.sortKeys;
+    keys.resize(n);
+    #pragma omp parallel for if(n>16384) schedule(static)
+    for (int i=0;i<n;i++) {
+        int c = g.cellIndex(s.x[i], s.y[i]);
+        uint32_t m = morton2d(uint32_t(c % g.cols), uint32_t(c / g.cols));
+        keys[i] = (uint64_t(m) << 32) | uint32_t(i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    permute(s.x, ctx.ftmp, keys, n);
+    permute(s.y, ctx.ftmp, keys, n);
+    permute(s.vx, ctx.ftmp, keys, n);
+    permute(s.vy, ctx.ftmp, keys, n);
+    permute(s.color, ctx.utmp, keys, n);
+    permute(s.id, ctx.itmp, keys, n);
+
+    // Los índices del grid incremental ya no son válidos
+    ctx.grid.invalidate();
+}
+
+void reorder_if_due(State& s, SimContext& ctx) {
+    if (ctx.reorderEvery > 0 && ctx.step % ctx.reorderEvery == 0)
+        reorder_morton(s, ctx);
+}
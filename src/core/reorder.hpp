@@ -0,0 +1,24 @@
+// src/core/reorder.hpp
+#pragma once
+#include "state.hpp"
+#include "sim_context.hpp"
+#include <cstdint>
+
+// Intercala los bits de (cx, cy) para obtener el código Morton (Z-order) de una celda
+inline uint32_t morton2d(uint32_t cx, uint32_t cy) {
+    auto spread = [](uint32_t v) {
+        v &= 0x0000FFFFu;
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    };
+    return spread(cx) | (spread(cy) << 1);
+}
+
+// Ordena todos los arreglos SoA del State por el código Morton de la celda de cada partícula.
+// Las partículas de una misma celda conservan su orden relativo; s.id sigue a cada partícula.
+void reorder_morton(State& s, SimContext& ctx);
+// Aplica reorder_morton si ctx.reorderEvery > 0 y toca en el paso actual
+void reorder_if_due(State& s, SimContext& ctx);
@@ -18,3 +18,30 @@ struct RNG {
         return a + (b-a) * ( (u32() >> 8) * (1.0f/16777216.0f) ); 
     }
 };
+
+// Generador por contador (Squares, Widynski 2020): sin estado, el valor depende solo de
+// (semilla, id, flujo). Cualquier hilo puede generar el número de cualquier partícula en
+// cualquier orden y el resultado es idéntico con 1 o N hilos.
+struct CounterRNG {
+    uint64_t key;
+    // La clave sale de la semilla con splitmix64 (impar y con bits mezclados, como pide Squares)
+    explicit CounterRNG(uint32_t seed=1u) {
+        uint64_t z = uint64_t(seed) + 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        key = (z ^ (z >> 31)) | 1ull;
+    }
+    // Entero de 32 bits para la partícula 'id' en el flujo 'stream' (hasta 256 flujos por id)
+    inline uint32_t u32(uint64_t id, uint32_t stream) const {
+        const uint64_t ctr = (id << 8) | (stream & 0xFFu);
+        uint64_t x = ctr * key, y = x, z = y + key;
+        x = x*x + y; x = (x >> 32) | (x << 32);
+        x = x*x + z; x = (x >> 32) | (x << 32);
+        x = x*x + y; x = (x >> 32) | (x << 32);
+        return uint32_t((x*x + z) >> 32);
+    }
+    // Flotante uniforme en [a, b) para (id, stream)
+    inline float uniform(uint64_t id, uint32_t stream, float a, float b) const {
+        return a + (b-a) * ( (u32(id, stream) >> 8) * (1.0f/16777216.0f) );
+    }
+};
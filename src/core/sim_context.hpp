@@ -0,0 +1,33 @@
+// src/core/sim_context.hpp
+#pragma once
+#include "grid.hpp"
+#include "compact_state.hpp"
+#include <cstdint>
+#include <vector>
+
+// Datos de la simulación que persisten entre frames (fuera del State de partículas)
+struct SimContext {
+    // Grid reutilizado en cada paso; se actualiza de forma incremental
+    Grid grid;
+    // Pasos simulados desde el inicio
+    long long step = 0;
+    // Paso de tiempo fijo de la simulación (s); el render interpola entre pasos
+    float dt = 1.0f/60.0f;
+    // Cada cuántos pasos reordenar el State por código Morton (0 = nunca)
+    int reorderEvery = 0;
+
+    // Buffers temporales del reordenamiento (se reutilizan entre llamadas)
+    std::vector<uint64_t> sortKeys;
+    AlignedArray<float> ftmp;
+    AlignedArray<uint32_t> utmp;
+    AlignedArray<int> itmp;
+
+    // Backend ws_tiles: límites de tiles (índices de celda)
+    std::vector<int> tiles;
+
+    // Backend compact: posiciones/velocidades en punto fijo de 16 bits (ver compact_state.hpp)
+    CompactState compact;
+
+    explicit SimContext(int width, int height)
+      : grid(width, height, 64) {}
+};
@@ -0,0 +1,217 @@
+// src/core/snapshot.cpp
+#include "snapshot.hpp"
+#include "affinity.hpp"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define SNAPSHOT_MMAP 1
+#endif
+
+static const char SNAPSHOT_MAGIC[8] = { 'P','S','N','A','P','S','H','T' };
+static constexpr uint32_t SNAPSHOT_ARRAYS = 6;
+
+bool write_snapshot(const std::string& path, const State& s, long long step) {
+    SnapshotHeader h{};
+    std::memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic));
+    h.version = SNAPSHOT_VERSION;
+    h.headerBytes = sizeof(SnapshotHeader);
+    h.n = s.N; h.width = s.width; h.height = s.height;
+    h.arrays = SNAPSHOT_ARRAYS;
+    h.step = step;
+    h.stride = s.x.padded();
+
+    // Se escribe a un temporal y se renombra: quien lea el archivo nunca ve uno a medias
+    const std::string tmp = path + ".tmp";
+    FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+    const size_t bytes = size_t(h.stride) * 4;
+    const void* arrays[SNAPSHOT_ARRAYS] = { s.x.data(), s.y.data(), s.vx.data(), s.vy.data(), s.color.data(), s.id.data() };
+    bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+    for (const void* a : arrays)
+        ok = ok && (bytes == 0 || std::fwrite(a, bytes, 1, f) == 1);
+    ok = (std::fclose(f) == 0) && ok;
+#ifdef _WIN32
+    if (ok) std::remove(path.c_str());  // rename no sobrescribe en Windows
+#endif
+    ok = ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+    if (!ok) std::remove(tmp.c_str());
+    return ok;
+}
+
+// Archivo mapeado completo; se libera cuando el último arreglo que lo adoptó lo suelta
+namespace {
+struct Mapping {
+    void* base = nullptr;
+    size_t size = 0;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE, map = nullptr;
+    ~Mapping() {
+        if (base) UnmapViewOfFile(base);
+        if (map) CloseHandle(map);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    }
+#elif defined(SNAPSHOT_MMAP)
+    ~Mapping() { if (base) munmap(base, size); }
+#else
+    ~Mapping() { ::operator delete(base, std::align_val_t(SIMD_ALIGN)); }
+#endif
+};
+
+// Mapea en modo copy-on-write: la simulación puede escribir sin tocar el archivo
+std::shared_ptr<Mapping> map_file(const std::string& path) {
+    auto m = std::make_shared<Mapping>();
+#if defined(_WIN32)
+    m->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m->file == INVALID_HANDLE_VALUE) throw std::runtime_error("No se pudo abrir el snapshot: " + path);
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(m->file, &sz)) throw std::runtime_error("No se pudo leer el tamaño del snapshot: " + path);
+    m->size = size_t(sz.QuadPart);
+    if (m->size == 0) return m;
+    m->map = CreateFileMappingA(m->file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (m->map) m->base = MapViewOfFile(m->map, FILE_MAP_COPY, 0, 0, 0);
+    if (!m->base) throw std::runtime_error("No se pudo mapear el snapshot: " + path);
+#elif defined(SNAPSHOT_MMAP)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("No se pudo abrir el snapshot: " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0) { ::close(fd); throw std::runtime_error("No se pudo leer el tamaño del snapshot: " + path); }
+    m->size = size_t(st.st_size);
+    if (m->size > 0) {
+        void* p = mmap(nullptr, m->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) m->base = p;
+    }
+    ::close(fd);
+    if (m->size > 0 && !m->base) throw std::runtime_error("No se pudo mapear el snapshot: " + path);
+#else
+    // Sin mmap: leer todo a un bloque alineado (misma disposición que el archivo)
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) throw std::runtime_error("No se pudo abrir el snapshot: " + path);
+    std::fseek(f, 0, SEEK_END);
+    m->size = size_t(std::ftell(f));
+    std::fseek(f, 0, SEEK_SET);
+    m->base = ::operator new(m->size ? m->size : 1, std::align_val_t(SIMD_ALIGN));
+    const bool ok = m->size == 0 || std::fread(m->base, m->size, 1, f) == 1;
+    std::fclose(f);
+    if (!ok) throw std::runtime_error("No se pudo leer el snapshot: " + path);
+#endif
+    return m;
+}
+} // namespace
+
+State load_snapshot(const std::string& path, long long* step) {
+    std::shared_ptr<Mapping> m = map_file(path);
+    SnapshotHeader h;
+    if (m->size < sizeof(h)) throw std::runtime_error("Snapshot truncado: " + path);
+    std::memcpy(&h, m->base, sizeof(h));
+    if (std::memcmp(h.magic, SNAPSHOT_MAGIC, sizeof(h.magic)) != 0)
+        throw std::runtime_error("No es un snapshot: " + path);
+    if (h.version != SNAPSHOT_VERSION)
+        throw std::runtime_error("Version de snapshot no soportada (" + std::to_string(h.version) + "): " + path);
+    if (h.headerBytes != sizeof(SnapshotHeader) || h.arrays != SNAPSHOT_ARRAYS || h.n < 0 || h.width <= 0 || h.height <= 0)
+        throw std::runtime_error("Encabezado de snapshot invalido: " + path);
+
+    constexpr uint64_t lanes = AlignedArray<float>::LANES;
+    if (h.stride != (uint64_t(h.n) + lanes - 1) / lanes * lanes)
+        throw std::runtime_error("Relleno de snapshot invalido: " + path);
+    const size_t bytes = size_t(h.stride) * 4;
+    if (m->size < sizeof(h) + SNAPSHOT_ARRAYS * bytes) throw std::runtime_error("Snapshot truncado: " + path);
+
+    State s(0, h.width, h.height);
+    // Los arreglos apuntan directo al mapeo (alineado a página + offsets múltiplos de 64 bytes)
+    char* base = static_cast<char*>(m->base) + sizeof(h);
+    auto at = [&](int k) { return base + size_t(k) * bytes; };
+    s.N = h.n;
+    s.x.adopt(reinterpret_cast<float*>(at(0)), size_t(h.n), m);
+    s.y.adopt(reinterpret_cast<float*>(at(1)), size_t(h.n), m);
+    s.vx.adopt(reinterpret_cast<float*>(at(2)), size_t(h.n), m);
+    s.vy.adopt(reinterpret_cast<float*>(at(3)), size_t(h.n), m);
+    s.color.adopt(reinterpret_cast<uint32_t*>(at(4)), size_t(h.n), m);
+    s.id.adopt(reinterpret_cast<int*>(at(5)), size_t(h.n), m);
+    // Los ids indexan TrailRing y el reordenamiento: deben ser una permutación de [0, N)
+    std::vector<char> seen(size_t(h.n), 0);
+    for (int i = 0; i < s.N; ++i) {
+        const int id = s.id[i];
+        if (id < 0 || id >= s.N || seen[size_t(id)])
+            throw std::runtime_error("Ids de snapshot invalidos (no son una permutacion de 0..N-1): " + path);
+        seen[size_t(id)] = 1;
+    }
+    if (step) *step = h.step;
+    return s;
+}
+
+// -------------------- Escritor asíncrono --------------------
+SnapshotWriter::SnapshotWriter(std::string p)
+  : pattern(std::move(p)), worker([this] { loop(); }) {}
+
+SnapshotWriter::~SnapshotWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stop = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+std::string SnapshotWriter::path_for(long long step) const {
+    const auto pos = pattern.find("{step}");
+    if (pos == std::string::npos) return pattern;
+    return pattern.substr(0, pos) + std::to_string(step) + pattern.substr(pos + 6);
+}
+
+bool SnapshotWriter::submit(const State& s, long long step) {
+    std::unique_ptr<Job> job;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (int(pending.size()) + (busy ? 1 : 0) >= MAX_PENDING) { ++nSkipped; return false; }
+        if (!spare.empty()) { job = std::move(spare.back()); spare.pop_back(); }
+    }
+    // La copia se hace fuera del lock (solo este hilo toca 'job' hasta encolarlo)
+    if (job) job->state = s;
+    else job.reset(new Job{ s, 0 });
+    job->step = step;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        pending.push_back(std::move(job));
+    }
+    cv.notify_all();
+    return true;
+}
+
+void SnapshotWriter::flush() {
+    std::unique_lock<std::mutex> lock(m);
+    cv.wait(lock, [this] { return pending.empty() && !busy; });
+}
+
+void SnapshotWriter::loop() {
+    // El hilo hereda la máscara de quien lo creó; con --bind ese suele ser main, atado al lugar del
+    // hilo 0 de OpenMP. La E/S corre en cualquier CPU permitida para no competir con él.
+    unpin_current_thread();
+    std::unique_lock<std::mutex> lock(m);
+    for (;;) {
+        cv.wait(lock, [this] { return stop || !pending.empty(); });
+        if (pending.empty()) return;  // stop y nada pendiente
+        std::unique_ptr<Job> job = std::move(pending.front());
+        pending.pop_front();
+        busy = true;
+        lock.unlock();
+        const bool ok = write_snapshot(path_for(job->step), job->state, job->step);
+        lock.lock();
+        busy = false;
+        if (ok) ++nWritten; else ++nFailed;
+        spare.push_back(std::move(job));
+        cv.notify_all();
+    }
+}
+
+int SnapshotWriter::written() const { std::lock_guard<std::mutex> lock(m); return nWritten; }
+int SnapshotWriter::skipped() const { std::lock_guard<std::mutex> lock(m); return nSkipped; }
+int SnapshotWriter::failed() const { std::lock_guard<std::mutex> lock(m); return nFailed; }
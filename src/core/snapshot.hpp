@@ -0,0 +1,72 @@
+// src/core/snapshot.hpp
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "state.hpp"
+
+// Formato binario de snapshot del State (little-endian):
+//   [SnapshotHeader de 64 bytes][x][y][vx][vy][color][id]
+// Cada arreglo ocupa 'stride' elementos de 4 bytes (N con relleno, múltiplo de 16), así todos
+// empiezan alineados a 64 bytes y el State restaurado puede apuntar directo al archivo mapeado.
+constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+    char magic[8];          // "PSNAPSHT"
+    uint32_t version;       // SNAPSHOT_VERSION
+    uint32_t headerBytes;   // sizeof(SnapshotHeader)
+    int32_t n, width, height;
+    uint32_t arrays;        // número de arreglos de 4 bytes que siguen (6)
+    int64_t step;           // paso de simulación en el que se tomó
+    uint64_t stride;        // elementos por arreglo (N redondeado al relleno)
+    uint8_t reserved[16];
+};
+static_assert(sizeof(SnapshotHeader) == 64, "el encabezado debe medir 64 bytes");
+
+// Escribe s de forma síncrona (a path.tmp y luego renombra). false si falla la escritura.
+bool write_snapshot(const std::string& path, const State& s, long long step);
+
+// Restaura un snapshot mapeando el archivo en memoria (copy-on-write, sin copiar los arreglos;
+// en plataformas sin mmap lo lee). Lanza std::runtime_error si el archivo no es válido.
+State load_snapshot(const std::string& path, long long* step = nullptr);
+
+// Escritor en segundo plano: submit copia el State (sin realocar tras la primera vez) y un hilo
+// propio lo escribe. Si ya hay MAX_PENDING snapshots esperando, el nuevo se omite: la simulación
+// nunca espera al disco.
+class SnapshotWriter {
+public:
+    static constexpr int MAX_PENDING = 2;
+
+    // pattern: ruta del archivo; "{step}" se reemplaza por el paso (si no está, se sobrescribe el mismo)
+    explicit SnapshotWriter(std::string pattern);
+    ~SnapshotWriter();
+
+    // false si se omitió porque la cola estaba llena
+    bool submit(const State& s, long long step);
+    // Espera a que se escriba todo lo encolado
+    void flush();
+
+    int written() const;
+    int skipped() const;
+    int failed() const;
+
+private:
+    struct Job { State state; long long step; };
+
+    void loop();
+    std::string path_for(long long step) const;
+
+    std::string pattern;
+    mutable std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::unique_ptr<Job>> pending;
+    std::vector<std::unique_ptr<Job>> spare;  // copias ya reservadas para reutilizar
+    bool busy = false, stop = false;
+    int nWritten = 0, nSkipped = 0, nFailed = 0;
+    std::thread worker;
+};
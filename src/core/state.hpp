@@ -3,6 +3,7 @@
 #include <cstdint>
 #include "types.hpp"
 #include "rng.hpp"
+#include "aligned_array.hpp"
 
 using namespace std;
 
@@ -12,24 +13,46 @@ struct State {
     // Tamaño de la ventana
     int width, height;
 
-    // Vectores con posiciones y velocidades
-    vector<float> x, y, vx, vy;
-    vector<uint32_t> color;
+    // Arreglos con posiciones y velocidades (alineados a 64 bytes y con relleno en cero hasta
+    // un múltiplo del ancho SIMD, ver AlignedArray)
+    AlignedArray<float> x, y, vx, vy;
+    AlignedArray<uint32_t> color;
+    // Identificador estable de cada partícula (se conserva al reordenar los arreglos)
+    AlignedArray<int> id;
+
+    // Flujos del generador por contador usados para cada atributo de la partícula
+    enum Stream : uint32_t { STREAM_X, STREAM_Y, STREAM_VX, STREAM_VY, STREAM_COLOR };
 
     // Esto es el constructor
     explicit State(int n, int w, int h, uint32_t seed=1234)
-      : N(n), width(w), height(h),
-        x(n), y(n), vx(n), vy(n), color(n)
+      : N(n), width(w), height(h)
     {
-        // Se asignan valores aleatorios a las posiciones y velocidades
-        RNG rng(seed);
-        for (int i=0;i<N;i++) {
-            x[i] = rng.uniform(0.0f, float(w));
-            y[i] = rng.uniform(0.0f, float(h));
-            vx[i] = rng.uniform(-120.0f, 120.0f);
-            vy[i] = rng.uniform(-120.0f, 120.0f);
+        // Reserva sin tocar las páginas; init_range hace el primer toque en paralelo con reparto
+        // estático, el mismo que usan los bucles de los backends: en máquinas NUMA cada página queda
+        // en el nodo del hilo que luego la procesa (en vez de todo en el nodo del hilo principal)
+        x.allocate(n); y.allocate(n); vx.allocate(n); vy.allocate(n); color.allocate(n); id.allocate(n);
+        init_range(0, int(x.padded()), seed);
+    }
+
+    // Inicializa las partículas [begin, end) en paralelo con valores aleatorios que dependen solo
+    // de (seed, i): el resultado no depende del número de hilos. Los índices >= N (relleno) quedan en cero.
+    void init_range(int begin, int end, uint32_t seed) {
+        const CounterRNG rng(seed);
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) if(end - begin > 65536)
+#endif
+        for (int i=begin;i<end;i++) {
+            if (i >= N) {
+                x[i] = 0.f; y[i] = 0.f; vx[i] = 0.f; vy[i] = 0.f; color[i] = 0u; id[i] = 0;
+                continue;
+            }
+            x[i] = rng.uniform(uint64_t(i), STREAM_X, 0.0f, float(width));
+            y[i] = rng.uniform(uint64_t(i), STREAM_Y, 0.0f, float(height));
+            vx[i] = rng.uniform(uint64_t(i), STREAM_VX, -120.0f, 120.0f);
+            vy[i] = rng.uniform(uint64_t(i), STREAM_VY, -120.0f, 120.0f);
             // Colores semi aleatorios, se inicia con 0xFF y se le asigna un color aleatorio
-            color[i] = 0xFF000000u | (rng.u32() & 0x00FFFFFFu);
+            color[i] = 0xFF000000u | (rng.u32(uint64_t(i), STREAM_COLOR) & 0x00FFFFFFu);
+            id[i] = i;
         }
     }
 };
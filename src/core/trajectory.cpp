@@ -0,0 +1,286 @@
+// src/core/trajectory.cpp
+#include "trajectory.hpp"
+#include "affinity.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+static const char TRAJECTORY_MAGIC[8] = { 'P','T','R','A','J','E','C','T' };
+
+namespace {
+
+inline uint32_t zigzag(int32_t v) { return (uint32_t(v) << 1) ^ uint32_t(v >> 31); }
+inline int32_t unzigzag(uint32_t u) { return int32_t((u >> 1) ^ (0u - (u & 1u))); }
+
+inline void put_varint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) { out.push_back(uint8_t(v | 0x80)); v >>= 7; }
+    out.push_back(uint8_t(v));
+}
+
+// Pasos entre dos frames grabados (los frames descartados no rompen la predicción)
+inline int32_t step_gap(long long step, long long prevStep) {
+    return int32_t(std::min(std::max(step - prevStep, 1LL), 1LL << 16));
+}
+
+// Punto fijo del predictor: 1/256 de cuanto
+constexpr int FIX_SHIFT = 8;
+constexpr int32_t FIX_ONE = 1 << FIX_SHIFT;
+// Topes del predictor para que ninguna cuenta desborde int32_t (gap llega a 2^16 y un primer residuo
+// grande con age == 1 da una velocidad grande). Con datos reales nunca se alcanzan: no cambian el
+// formato, solo evitan comportamiento indefinido con saltos largos o flujos corruptos.
+constexpr int64_t POS_LIMIT = INT32_MAX - FIX_ONE;  // deja lugar al redondeo de predict
+constexpr int64_t VEL_LIMIT = int64_t(1) << 20;     // 4096 cuantos por paso
+constexpr int64_t AGE_LIMIT = int64_t(1) << 30;
+
+inline int32_t clamp64(int64_t v, int64_t limit) { return int32_t(std::clamp(v, -limit, limit)); }
+
+void reset_axis(TrajectoryAxis& a, int n) {
+    a.pos.assign(n, 0); a.vel.assign(n, 0); a.age.assign(n, 0);
+}
+
+// Avanza la predicción de la partícula i 'gap' pasos y devuelve la posición esperada (en cuantos).
+// La usan el escritor y el lector, así que los topes dan el mismo resultado en ambos lados.
+inline int32_t predict(TrajectoryAxis& a, int i, int32_t gap) {
+    a.pos[i] = clamp64(int64_t(a.pos[i]) + int64_t(a.vel[i]) * gap, POS_LIMIT);
+    a.age[i] = clamp64(int64_t(a.age[i]) + gap, AGE_LIMIT);
+    return (a.pos[i] + FIX_ONE/2) >> FIX_SHIFT;
+}
+
+// Aplica un residuo distinto de cero: corrige la velocidad con el error acumulado desde la última
+// corrección y fija la posición en la reconstruida
+inline void correct(TrajectoryAxis& a, int i, int32_t pred, int32_t res) {
+    a.vel[i] = clamp64(int64_t(a.vel[i]) + int64_t(res) * FIX_ONE / a.age[i], VEL_LIMIT);
+    a.pos[i] = clamp64((int64_t(pred) + res) * FIX_ONE, POS_LIMIT);
+    a.age[i] = 0;
+}
+
+// En un keyframe el residuo es la posición absoluta y el predictor arranca quieto
+inline void restart(TrajectoryAxis& a, int i, int32_t q) {
+    a.pos[i] = clamp64(int64_t(q) * FIX_ONE, POS_LIMIT); a.vel[i] = 0; a.age[i] = 0;
+}
+
+// Codifica una coordenada de n partículas (q en cuantos, por id) y avanza el predictor
+void encode_axis(const int32_t* q, TrajectoryAxis& a, int n, bool key, int32_t gap, int deadband,
+                 std::vector<uint8_t>& out) {
+    uint32_t zeros = 0;
+    for (int i=0;i<n;i++) {
+        int32_t res;
+        if (key) {
+            res = q[i];
+            restart(a, i, q[i]);
+        } else {
+            const int32_t pred = predict(a, i, gap);
+            res = q[i] - pred;
+            if (res >= -deadband && res <= deadband) res = 0;
+            else correct(a, i, pred, res);
+        }
+        if (res == 0) { ++zeros; continue; }
+        put_varint(out, zeros);
+        put_varint(out, zigzag(res) - 1);  // zigzag(res) >= 1 para res != 0
+        zeros = 0;
+    }
+    put_varint(out, zeros);
+}
+
+// Inverso de encode_axis; devuelve la posición tras la coordenada o lanza si el flujo no alcanza
+size_t decode_axis(const uint8_t* in, size_t size, size_t pos, TrajectoryAxis& a, int n, bool key, int32_t gap) {
+    auto get = [&]() {
+        uint32_t v = 0;
+        for (int shift = 0; ; shift += 7) {
+            if (pos >= size || shift > 28) throw std::runtime_error("Frame de trayectoria corrupto");
+            const uint8_t b = in[pos++];
+            v |= uint32_t(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+    };
+    uint32_t zeros = get();
+    for (int i=0;i<n;i++) {
+        int32_t res = 0;
+        if (zeros > 0) {
+            --zeros;
+        } else {
+            res = unzigzag(get() + 1);
+            zeros = get();
+        }
+        if (key) {
+            restart(a, i, res);
+        } else {
+            const int32_t pred = predict(a, i, gap);
+            if (res != 0) correct(a, i, pred, res);
+        }
+    }
+    if (zeros != 0) throw std::runtime_error("Frame de trayectoria corrupto");
+    return pos;
+}
+
+} // namespace
+
+// -------------------- Escritor --------------------
+TrajectoryWriter::TrajectoryWriter(const std::string& path, int n_, int width, int height, float tolerance)
+  : n(n_), invQuantum(4.0f / tolerance)
+{
+    const float quantum = tolerance / 4.0f;
+    // Posiciones en 1/256 de cuanto deben caber holgadas en int32
+    if (!(quantum > 0.0f) || float(std::max(width, height)) * invQuantum > float(1 << 22))
+        throw std::runtime_error("Tolerancia de trayectoria fuera de rango");
+    file = std::fopen(path.c_str(), "wb");
+    if (!file) throw std::runtime_error("No se pudo crear la trayectoria: " + path);
+    std::setvbuf(file, nullptr, _IOFBF, size_t(1) << 20);
+
+    TrajectoryHeader h{};
+    std::memcpy(h.magic, TRAJECTORY_MAGIC, sizeof(h.magic));
+    h.version = TRAJECTORY_VERSION;
+    h.n = n; h.width = width; h.height = height;
+    h.quantum = quantum;
+    h.keyframeEvery = KEYFRAME_EVERY;
+    h.deadband = DEADBAND;
+    if (std::fwrite(&h, sizeof(h), 1, file) != 1) ioError = true;
+    nBytes = sizeof(h);
+
+    reset_axis(ax, n); reset_axis(ay, n);
+    // Cola acotada: todos los buffers se reservan aquí, submit nunca aloca
+    for (int k=0;k<QUEUE_FRAMES;k++) {
+        auto f = std::make_unique<Frame>();
+        f->qx.resize(n); f->qy.resize(n);
+        spare.push_back(std::move(f));
+    }
+    worker = std::thread([this] { loop(); });
+}
+
+TrajectoryWriter::~TrajectoryWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stop = true;
+    }
+    cv.notify_all();
+    worker.join();
+    std::fclose(file);
+}
+
+bool TrajectoryWriter::submit(const State& s, long long step) {
+    if (s.N != n) throw std::runtime_error("La trayectoria espera N constante");
+    std::unique_ptr<Frame> f;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (spare.empty() || ioError) { ++nDropped; return false; }
+        f = std::move(spare.back());
+        spare.pop_back();
+    }
+    // Cuantizar en orden de id (fuera del lock: solo este hilo toca 'f' hasta encolarlo).
+    // Con signo: las colisiones pueden dejar partículas unos píxeles fuera del área (x < 0).
+    int32_t* qx = f->qx.data();
+    int32_t* qy = f->qy.data();
+    const float iq = invQuantum;
+    #pragma omp parallel for if(n>65536) schedule(static)
+    for (int i=0;i<n;i++) {
+        const int id = s.id[i];
+        qx[id] = int32_t(std::floor(s.x[i] * iq + 0.5f));
+        qy[id] = int32_t(std::floor(s.y[i] * iq + 0.5f));
+    }
+    f->step = step;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        pending.push_back(std::move(f));
+    }
+    cv.notify_all();
+    return true;
+}
+
+void TrajectoryWriter::encode(const Frame& f) {
+    const bool key = sinceKey == 0;
+    const int32_t gap = step_gap(f.step, prevStep);
+    prevStep = f.step;
+    out.clear();
+    encode_axis(f.qx.data(), ax, n, key, gap, DEADBAND, out);
+    encode_axis(f.qy.data(), ay, n, key, gap, DEADBAND, out);
+    sinceKey = (sinceKey + 1 == KEYFRAME_EVERY) ? 0 : sinceKey + 1;
+
+    TrajectoryFrame fh{};
+    fh.step = f.step;
+    fh.bytes = uint32_t(out.size());
+    fh.keyframe = key ? 1u : 0u;
+    const bool ok = std::fwrite(&fh, sizeof(fh), 1, file) == 1
+                 && (out.empty() || std::fwrite(out.data(), out.size(), 1, file) == 1);
+    std::lock_guard<std::mutex> lock(m);
+    if (ok) { ++nFrames; nBytes += (long long)(sizeof(fh) + out.size()); }
+    else ioError = true;
+}
+
+void TrajectoryWriter::flush() {
+    std::unique_lock<std::mutex> lock(m);
+    cv.wait(lock, [this] { return pending.empty() && !busy; });
+    if (std::fflush(file) != 0) ioError = true;
+}
+
+void TrajectoryWriter::loop() {
+    // El hilo hereda la máscara de quien lo creó; con --bind ese suele ser main, atado al lugar del
+    // hilo 0 de OpenMP. La E/S corre en cualquier CPU permitida para no competir con él.
+    unpin_current_thread();
+    std::unique_lock<std::mutex> lock(m);
+    for (;;) {
+        cv.wait(lock, [this] { return stop || !pending.empty(); });
+        if (pending.empty()) return;  // stop y nada pendiente
+        std::unique_ptr<Frame> f = std::move(pending.front());
+        pending.pop_front();
+        busy = true;
+        const bool skip = ioError;
+        lock.unlock();
+        if (!skip) encode(*f);
+        lock.lock();
+        busy = false;
+        spare.push_back(std::move(f));
+        cv.notify_all();
+    }
+}
+
+long long TrajectoryWriter::frames() const { std::lock_guard<std::mutex> lock(m); return nFrames; }
+long long TrajectoryWriter::dropped() const { std::lock_guard<std::mutex> lock(m); return nDropped; }
+long long TrajectoryWriter::bytes() const { std::lock_guard<std::mutex> lock(m); return nBytes; }
+bool TrajectoryWriter::failed() const { std::lock_guard<std::mutex> lock(m); return ioError; }
+
+// -------------------- Lector --------------------
+TrajectoryReader::TrajectoryReader(const std::string& path) {
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) throw std::runtime_error("No se pudo abrir la trayectoria: " + path);
+    if (std::fread(&h, sizeof(h), 1, file) != 1 || std::memcmp(h.magic, TRAJECTORY_MAGIC, sizeof(h.magic)) != 0) {
+        std::fclose(file);
+        throw std::runtime_error("No es una trayectoria: " + path);
+    }
+    if (h.version != TRAJECTORY_VERSION || h.n < 0 || !(h.quantum > 0.0f) || h.keyframeEvery == 0) {
+        std::fclose(file);
+        throw std::runtime_error("Encabezado de trayectoria invalido: " + path);
+    }
+    reset_axis(ax, h.n); reset_axis(ay, h.n);
+}
+
+TrajectoryReader::~TrajectoryReader() {
+    if (file) std::fclose(file);
+}
+
+bool TrajectoryReader::next(std::vector<float>& x, std::vector<float>& y, long long& step) {
+    TrajectoryFrame fh;
+    if (std::fread(&fh, sizeof(fh), 1, file) != 1) return false;
+    in.resize(fh.bytes);
+    if (fh.bytes > 0 && std::fread(in.data(), fh.bytes, 1, file) != 1)
+        throw std::runtime_error("Frame de trayectoria truncado");
+    if ((fh.keyframe != 0) != (sinceKey == 0)) throw std::runtime_error("Frame de trayectoria corrupto");
+
+    const int n = h.n;
+    const bool key = sinceKey == 0;
+    const int32_t gap = step_gap(fh.step, prevStep);
+    prevStep = fh.step;
+    size_t pos = decode_axis(in.data(), in.size(), 0, ax, n, key, gap);
+    pos = decode_axis(in.data(), in.size(), pos, ay, n, key, gap);
+    if (pos != in.size()) throw std::runtime_error("Frame de trayectoria corrupto");
+    sinceKey = (sinceKey + 1 == h.keyframeEvery) ? 0 : sinceKey + 1;
+
+    x.resize(n); y.resize(n);
+    // Posición reconstruida = predicción redondeada (la misma que usó el codificador)
+    for (int i=0;i<n;i++) {
+        x[i] = float((ax.pos[i] + FIX_ONE/2) >> FIX_SHIFT) * h.quantum;
+        y[i] = float((ay.pos[i] + FIX_ONE/2) >> FIX_SHIFT) * h.quantum;
+    }
+    step = fh.step;
+    return true;
+}
@@ -0,0 +1,115 @@
+// src/core/trajectory.hpp
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "state.hpp"
+
+// Grabación de trayectorias (posiciones por frame) en un flujo comprimido:
+//   [TrajectoryHeader de 48 bytes] ([TrajectoryFrame de 16 bytes][x][y])*
+// Las posiciones se cuantizan (con signo) a múltiplos de 'quantum' píxeles y se ordenan por id (el
+// orden de los arreglos cambia al reordenar). Cada coordenada se predice con velocidad constante; la
+// velocidad es de punto fijo (1/256 de cuanto por paso) y se corrige con cada residuo, así que la
+// predicción sigue también a las partículas que avanzan fracciones de cuanto por paso (y salta los
+// frames descartados). El codificador acepta la predicción si el error es de a lo sumo 'deadband'
+// cuantos (error total <= deadband + 0.5 cuantos), de modo que casi todos los residuos son cero salvo
+// rebotes y choques. Los residuos pasan por zigzag y se escriben como varint(ceros seguidos),
+// varint(valor distinto de cero), ..., varint(ceros finales).
+constexpr uint32_t TRAJECTORY_VERSION = 1;
+
+struct TrajectoryHeader {
+    char magic[8];          // "PTRAJECT"
+    uint32_t version;       // TRAJECTORY_VERSION
+    int32_t n, width, height;
+    float quantum;          // píxeles por unidad cuantizada
+    uint32_t keyframeEvery; // cada cuántos frames se reinicia la predicción
+    uint32_t deadband;      // tolerancia del codificador en cuantos (informativo, el lector no la usa)
+    uint32_t reserved[3];
+};
+static_assert(sizeof(TrajectoryHeader) == 48, "el encabezado debe medir 48 bytes");
+
+struct TrajectoryFrame {
+    int64_t step;           // paso de simulación del frame
+    uint32_t bytes;         // bytes comprimidos que siguen (x e y)
+    uint32_t keyframe;      // 1 si la predicción parte de cero
+};
+static_assert(sizeof(TrajectoryFrame) == 16, "el encabezado de frame debe medir 16 bytes");
+
+// Estado del predictor de una coordenada (idéntico en el escritor y el lector)
+struct TrajectoryAxis {
+    std::vector<int32_t> pos;  // posición reconstruida, en 1/256 de cuanto
+    std::vector<int32_t> vel;  // velocidad estimada, en 1/256 de cuanto por paso
+    std::vector<int32_t> age;  // pasos desde la última corrección
+};
+
+// Escritor en segundo plano: submit cuantiza el State (en paralelo) en uno de QUEUE_FRAMES buffers
+// preasignados y un hilo propio codifica y escribe. Si no hay buffer libre el frame se descarta:
+// la simulación nunca espera al disco. Lanza std::runtime_error si no puede crear el archivo.
+class TrajectoryWriter {
+public:
+    static constexpr int QUEUE_FRAMES = 4;
+    static constexpr int KEYFRAME_EVERY = 600;
+    static constexpr int DEADBAND = 3;
+
+    // tolerance: error máximo en píxeles de las posiciones grabadas (cuanto = tolerance / 4)
+    TrajectoryWriter(const std::string& path, int n, int width, int height, float tolerance);
+    ~TrajectoryWriter();
+
+    // false si el frame se descartó porque la cola estaba llena
+    bool submit(const State& s, long long step);
+    // Espera a que se escriba todo lo encolado
+    void flush();
+
+    long long frames() const;
+    long long dropped() const;
+    long long bytes() const;
+    bool failed() const;
+
+private:
+    struct Frame { std::vector<int32_t> qx, qy; long long step; };
+
+    void loop();
+    void encode(const Frame& f);
+
+    FILE* file = nullptr;
+    int n;
+    float invQuantum;
+    // Solo los usa el hilo escritor: predictores y el frame codificado
+    TrajectoryAxis ax, ay;
+    std::vector<uint8_t> out;
+    long long sinceKey = 0, prevStep = 0;
+
+    mutable std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::unique_ptr<Frame>> pending;
+    std::vector<std::unique_ptr<Frame>> spare;
+    bool busy = false, stop = false, ioError = false;
+    long long nFrames = 0, nDropped = 0, nBytes = 0;
+    std::thread worker;
+};
+
+// Lector secuencial del flujo (p. ej. para reproducir o verificar una grabación)
+class TrajectoryReader {
+public:
+    // Lanza std::runtime_error si el archivo no existe o no es una trayectoria
+    explicit TrajectoryReader(const std::string& path);
+    ~TrajectoryReader();
+
+    const TrajectoryHeader& header() const { return h; }
+    // Siguiente frame: posiciones en píxeles indexadas por id. false al final del archivo;
+    // lanza std::runtime_error si el frame está truncado o corrupto.
+    bool next(std::vector<float>& x, std::vector<float>& y, long long& step);
+
+private:
+    FILE* file = nullptr;
+    TrajectoryHeader h{};
+    TrajectoryAxis ax, ay;
+    std::vector<uint8_t> in;
+    long long sinceKey = 0, prevStep = 0;
+};
@@ -0,0 +1,38 @@
+// src/core/triple_buffer.hpp
+#pragma once
+#include <atomic>
+
+// Triple buffer sin locks entre un productor (simulación) y un consumidor (render).
+// El productor escribe en back() y llama publish(); el consumidor llama latest() y obtiene
+// el último frame completo. Ninguno espera al otro: el índice listo se intercambia con un exchange.
+template <class T>
+class TripleBuffer {
+public:
+    // Las tres copias arrancan iguales a 'init'
+    explicit TripleBuffer(const T& init) : buf_{init, init, init} {}
+
+    // Copia donde escribe el productor (solo la toca el hilo productor)
+    T& back() { return buf_[write_]; }
+
+    // Publica back() como el frame más reciente y toma la copia que estaba lista como nuevo back()
+    void publish() {
+        const unsigned prev = ready_.exchange(unsigned(write_) | FRESH, std::memory_order_acq_rel);
+        write_ = int(prev & INDEX);
+    }
+
+    // Último frame publicado que el consumidor no ha visto; nullptr si no hay uno nuevo.
+    // El puntero es válido hasta la siguiente llamada (solo la toca el hilo consumidor).
+    const T* latest() {
+        if (!(ready_.load(std::memory_order_relaxed) & FRESH)) return nullptr;
+        const unsigned prev = ready_.exchange(unsigned(read_), std::memory_order_acq_rel);
+        read_ = int(prev & INDEX);
+        return &buf_[read_];
+    }
+
+private:
+    static constexpr unsigned INDEX = 3u, FRESH = 4u;
+    T buf_[3];
+    // Índice listo para el consumidor (+ bit FRESH si aún no se leyó); write_/read_ son privados de cada hilo
+    std::atomic<unsigned> ready_{1u};
+    int write_ = 0, read_ = 2;
+};
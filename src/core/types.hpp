@@ -1,9 +1,15 @@
 #pragma once
 #include <cstdint>
+#include <string>
 
 // Esto es para la configuración del renderizador
 struct RendererConfig {
     int width;
     int height;
     bool vsync = false;
+    // Si no vacío, los renderers con framebuffer propio guardan ahí la imagen del último frame
+    // ("{frame}" = número de frame; .png o .ppm)
+    std::string output;
+    // Con output: guardar uno de cada frameEvery frames en lugar de solo el último (0 = solo el último)
+    int frameEvery = 0;
 };
@@ -0,0 +1,93 @@
+// src/core/work_stealing.cpp
+#include "work_stealing.hpp"
+#include "affinity.hpp"
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int threads)
+  : nThreads(std::max(1, threads))
+{
+    for (int i = 0; i < nThreads; ++i) queues.push_back(std::make_unique<Queue>());
+    for (int i = 1; i < nThreads; ++i) workers.emplace_back([this, i] { worker_loop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stop = true;
+    }
+    wakeCv.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+void WorkStealingPool::run(int nTasks, const TaskFn& fn) {
+    if (nTasks <= 0) return;
+    if (nThreads == 1) {
+        for (int t = 0; t < nTasks; ++t) fn(t);
+        return;
+    }
+    // current y remaining se publican antes que las tareas (el mutex de cada cola ordena el acceso)
+    current = &fn;
+    remaining.store(nTasks, std::memory_order_relaxed);
+    for (int q = 0; q < nThreads; ++q) {
+        const int b = int(int64_t(nTasks) * q / nThreads), e = int(int64_t(nTasks) * (q + 1) / nThreads);
+        std::lock_guard<std::mutex> lock(queues[q]->m);
+        for (int t = b; t < e; ++t) queues[q]->tasks.push_back(t);
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        generation.fetch_add(1, std::memory_order_release);
+    }
+    wakeCv.notify_all();
+
+    drain(0);
+    // Esperar a que los demás terminen las tareas que ya tomaron
+    while (remaining.load(std::memory_order_acquire) > 0) std::this_thread::yield();
+}
+
+bool WorkStealingPool::pop_or_steal(int id, int& task) {
+    {
+        Queue& own = *queues[id];
+        std::lock_guard<std::mutex> lock(own.m);
+        if (!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (int k = 1; k < nThreads; ++k) {
+        Queue& victim = *queues[(id + k) % nThreads];
+        std::lock_guard<std::mutex> lock(victim.m);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::drain(int id) {
+    int task;
+    while (pop_or_steal(id, task)) {
+        (*current)(task);
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void WorkStealingPool::worker_loop(int id) {
+    // Con --bind, mismo lugar que el hilo OpenMP de igual índice (el trabajador 0 es quien llama a run)
+    pin_worker(id, nThreads);
+    uint64_t seen = 0;
+    for (;;) {
+        // Espera activa breve (los pasos llegan cada pocos ms) y luego dormir
+        for (int spin = 0; spin < 4000 && generation.load(std::memory_order_acquire) == seen && !stop; ++spin)
+            std::this_thread::yield();
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCv.wait(lock, [&] { return stop || generation.load(std::memory_order_acquire) != seen; });
+            if (stop) return;
+            seen = generation.load(std::memory_order_acquire);
+        }
+        drain(id);
+    }
+}
@@ -0,0 +1,50 @@
+// src/core/work_stealing.hpp
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de hilos persistente con una cola por participante y robo de trabajo.
+// run() reparte las tareas en bloques contiguos entre las colas; cada hilo saca de su cola por
+// el final (LIFO, datos aún en caché) y, al vaciarse, roba del inicio de las colas ajenas (FIFO).
+// El hilo que llama a run() participa como trabajador 0.
+class WorkStealingPool {
+public:
+    using TaskFn = std::function<void(int task)>;
+
+    explicit WorkStealingPool(int threads);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int threads() const { return nThreads; }
+    // Ejecuta fn(t) para t en [0, nTasks) y regresa cuando todas terminaron
+    void run(int nTasks, const TaskFn& fn);
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<int> tasks;
+    };
+
+    void worker_loop(int id);
+    bool pop_or_steal(int id, int& task);
+    void drain(int id);
+
+    int nThreads;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    std::atomic<uint64_t> generation{0};
+    std::atomic<bool> stop{false};
+    std::atomic<int> remaining{0};
+    const TaskFn* current = nullptr;
+};
@@ -0,0 +1,204 @@
+// src/gfx/frame_encoder.cpp
+#include "frame_encoder.hpp"
+#include "core/affinity.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+// Fila ARGB8888 -> RGB de 8 bits
+inline void argb_to_rgb(const uint32_t* p, int width, unsigned char* out) {
+    for (int x = 0; x < width; ++x) {
+        out[3*x + 0] = (p[x] >> 16) & 0xFF;
+        out[3*x + 1] = (p[x] >> 8) & 0xFF;
+        out[3*x + 2] = p[x] & 0xFF;
+    }
+}
+
+// CRC-32 de PNG/zlib (polinomio reflejado 0xEDB88320), con tabla de 256 entradas
+const std::array<uint32_t, 256>& crc_table() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[n] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Actualiza un CRC sin invertir (empezar en 0xFFFFFFFF e invertir al final)
+inline uint32_t crc_update(uint32_t c, const unsigned char* p, size_t n) {
+    const auto& t = crc_table();
+    for (size_t i = 0; i < n; ++i) c = t[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+    return c;
+}
+
+// Adler-32 de zlib; se reduce módulo 65521 cada 5552 bytes (lo máximo sin desbordar 32 bits)
+uint32_t adler32(const unsigned char* p, size_t n) {
+    uint32_t a = 1, b = 0;
+    while (n > 0) {
+        const size_t len = std::min<size_t>(n, 5552);
+        for (size_t i = 0; i < len; ++i) { a += p[i]; b += a; }
+        a %= 65521; b %= 65521;
+        p += len; n -= len;
+    }
+    return (b << 16) | a;
+}
+
+inline void put_be32(unsigned char* p, uint32_t v) {
+    p[0] = uint8_t(v >> 24); p[1] = uint8_t(v >> 16); p[2] = uint8_t(v >> 8); p[3] = uint8_t(v);
+}
+
+// Chunk PNG: longitud, tipo, datos y CRC de tipo+datos
+bool write_chunk(FILE* f, const char type[4], const unsigned char* data, size_t n) {
+    unsigned char head[8];
+    put_be32(head, uint32_t(n));
+    std::memcpy(head + 4, type, 4);
+    unsigned char crc[4];
+    put_be32(crc, crc_update(crc_update(0xFFFFFFFFu, head + 4, 4), data, n) ^ 0xFFFFFFFFu);
+    return std::fwrite(head, 8, 1, f) == 1
+        && (n == 0 || std::fwrite(data, n, 1, f) == 1)
+        && std::fwrite(crc, 4, 1, f) == 1;
+}
+
+} // namespace
+
+bool write_ppm(const std::string& path, const uint32_t* argb, int width, int height) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", width, height);
+    std::vector<unsigned char> row(size_t(width) * 3);
+    bool ok = true;
+    for (int y = 0; y < height && ok; ++y) {
+        argb_to_rgb(argb + size_t(y) * width, width, row.data());
+        ok = std::fwrite(row.data(), row.size(), 1, f) == 1;
+    }
+    return (std::fclose(f) == 0) && ok;
+}
+
+bool write_png(const std::string& path, const uint32_t* argb, int width, int height) {
+    // Datos sin comprimir: cada fila lleva un byte de filtro (0 = ninguno) y luego RGB
+    const size_t rowBytes = size_t(width) * 3 + 1;
+    std::vector<unsigned char> raw(rowBytes * size_t(height));
+    for (int y = 0; y < height; ++y) {
+        unsigned char* r = raw.data() + size_t(y) * rowBytes;
+        r[0] = 0;
+        argb_to_rgb(argb + size_t(y) * width, width, r + 1);
+    }
+
+    // Flujo zlib: CMF/FLG (deflate, ventana de 32K, sin diccionario), bloques "stored" de hasta
+    // 65535 bytes (BFINAL/BTYPE, LEN, NLEN en little endian) y Adler-32 de los datos sin comprimir
+    constexpr size_t MAX_STORED = 65535;
+    const size_t blocks = std::max<size_t>(1, (raw.size() + MAX_STORED - 1) / MAX_STORED);
+    std::vector<unsigned char> z;
+    z.reserve(2 + blocks * 5 + raw.size() + 4);
+    z.push_back(0x78); z.push_back(0x01);
+    for (size_t off = 0, b = 0; b < blocks; ++b) {
+        const size_t len = std::min(MAX_STORED, raw.size() - off);
+        z.push_back(b + 1 == blocks ? 1 : 0);
+        z.push_back(uint8_t(len)); z.push_back(uint8_t(len >> 8));
+        z.push_back(uint8_t(~len)); z.push_back(uint8_t(~len >> 8));
+        z.insert(z.end(), raw.begin() + off, raw.begin() + off + len);
+        off += len;
+    }
+    unsigned char adler[4];
+    put_be32(adler, adler32(raw.data(), raw.size()));
+    z.insert(z.end(), adler, adler + 4);
+
+    // IHDR: ancho, alto, 8 bits, color RGB (2), compresión 0, filtro 0, sin entrelazado
+    unsigned char ihdr[13];
+    put_be32(ihdr, uint32_t(width));
+    put_be32(ihdr + 4, uint32_t(height));
+    ihdr[8] = 8; ihdr[9] = 2; ihdr[10] = 0; ihdr[11] = 0; ihdr[12] = 0;
+
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    static const unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    const bool ok = std::fwrite(PNG_SIGNATURE, sizeof(PNG_SIGNATURE), 1, f) == 1
+                 && write_chunk(f, "IHDR", ihdr, sizeof(ihdr))
+                 && write_chunk(f, "IDAT", z.data(), z.size())
+                 && write_chunk(f, "IEND", nullptr, 0);
+    return (std::fclose(f) == 0) && ok;
+}
+
+bool write_image(const std::string& path, const uint32_t* argb, int width, int height) {
+    std::string ext = path.size() >= 4 ? path.substr(path.size() - 4) : std::string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return ext == ".png" ? write_png(path, argb, width, height) : write_ppm(path, argb, width, height);
+}
+
+// -------------------- Codificador asíncrono --------------------
+FrameEncoder::FrameEncoder(std::string p)
+  : pattern(std::move(p)), worker([this] { loop(); }) {}
+
+FrameEncoder::~FrameEncoder() {
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stop = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+std::string FrameEncoder::path_for(long long frame) const {
+    const auto pos = pattern.find("{frame}");
+    if (pos == std::string::npos) return pattern;
+    char num[32];
+    std::snprintf(num, sizeof(num), "%06lld", frame);
+    return pattern.substr(0, pos) + num + pattern.substr(pos + 7);
+}
+
+bool FrameEncoder::submit(const uint32_t* argb, int width, int height, long long frame) {
+    std::unique_ptr<Job> job;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (int(pending.size()) + (busy ? 1 : 0) >= MAX_PENDING) { ++nSkipped; return false; }
+        if (!spare.empty()) { job = std::move(spare.back()); spare.pop_back(); }
+    }
+    // La copia se hace fuera del lock (solo este hilo toca 'job' hasta encolarlo)
+    if (!job) job.reset(new Job{ {}, 0, 0, 0 });
+    job->pixels.assign(argb, argb + size_t(width) * height);
+    job->width = width; job->height = height; job->frame = frame;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        pending.push_back(std::move(job));
+    }
+    cv.notify_all();
+    return true;
+}
+
+void FrameEncoder::flush() {
+    std::unique_lock<std::mutex> lock(m);
+    cv.wait(lock, [this] { return pending.empty() && !busy; });
+}
+
+void FrameEncoder::loop() {
+    // El hilo hereda la máscara de quien lo creó; con --bind ese suele ser main, atado al lugar del
+    // hilo 0 de OpenMP. La E/S corre en cualquier CPU permitida para no competir con él.
+    unpin_current_thread();
+    std::unique_lock<std::mutex> lock(m);
+    for (;;) {
+        cv.wait(lock, [this] { return stop || !pending.empty(); });
+        if (pending.empty()) return;  // stop y nada pendiente
+        std::unique_ptr<Job> job = std::move(pending.front());
+        pending.pop_front();
+        busy = true;
+        lock.unlock();
+        const bool ok = write_image(path_for(job->frame), job->pixels.data(), job->width, job->height);
+        lock.lock();
+        busy = false;
+        if (ok) ++nWritten; else ++nFailed;
+        spare.push_back(std::move(job));
+        cv.notify_all();
+    }
+}
+
+int FrameEncoder::written() const { std::lock_guard<std::mutex> lock(m); return nWritten; }
+int FrameEncoder::skipped() const { std::lock_guard<std::mutex> lock(m); return nSkipped; }
+int FrameEncoder::failed() const { std::lock_guard<std::mutex> lock(m); return nFailed; }
@@ -0,0 +1,54 @@
+// src/gfx/frame_encoder.hpp
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Escritura de frames ARGB8888 (pitch = ancho) como imagen RGB de 8 bits por canal.
+// PPM binario (P6): sin compresión, lo abre cualquier visor y ffmpeg.
+bool write_ppm(const std::string& path, const uint32_t* argb, int width, int height);
+// PNG sin dependencias: IDAT con bloques deflate "stored" (sin comprimir), filtro 0, CRC32 y Adler32
+bool write_png(const std::string& path, const uint32_t* argb, int width, int height);
+// PNG si la ruta termina en ".png" (sin distinguir mayúsculas), si no PPM
+bool write_image(const std::string& path, const uint32_t* argb, int width, int height);
+
+// Codificador en segundo plano: submit copia el framebuffer a un buffer reutilizable y un hilo propio
+// lo escribe. Si ya hay MAX_PENDING frames en vuelo el frame se omite: el render nunca espera al disco.
+class FrameEncoder {
+public:
+    static constexpr int MAX_PENDING = 2;
+
+    // pattern: ruta del archivo; "{frame}" se reemplaza por el número de frame con 6 dígitos
+    // (frame_{frame}.png -> frame_000060.png); si no está, se sobrescribe el mismo archivo
+    explicit FrameEncoder(std::string pattern);
+    ~FrameEncoder();
+
+    // false si se omitió porque la cola estaba llena
+    bool submit(const uint32_t* argb, int width, int height, long long frame);
+    // Espera a que se escriba todo lo encolado
+    void flush();
+
+    std::string path_for(long long frame) const;
+    int written() const;
+    int skipped() const;
+    int failed() const;
+
+private:
+    struct Job { std::vector<uint32_t> pixels; int width, height; long long frame; };
+
+    void loop();
+
+    std::string pattern;
+    mutable std::mutex m;
+    std::condition_variable cv;
+    std::deque<std::unique_ptr<Job>> pending;
+    std::vector<std::unique_ptr<Job>> spare;  // buffers ya reservados para reutilizar
+    bool busy = false, stop = false;
+    int nWritten = 0, nSkipped = 0, nFailed = 0;
+    std::thread worker;
+};
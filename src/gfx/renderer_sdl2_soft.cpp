@@ -0,0 +1,120 @@
+// src/gfx/renderer_sdl2_soft.cpp
+#include "gfx/renderer.hpp"
+#include "gfx/soft_raster.hpp"
+#include "core/profile.hpp"
+#include <SDL2/SDL.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// Modo clásico rasterizado por software (en paralelo con OpenMP) directamente sobre una textura
+// SDL_TEXTUREACCESS_STREAMING: por frame solo hay un lock/unlock, un RenderCopy y el present,
+// así el costo del render escala con los núcleos igual que la simulación.
+class SDL2SoftRenderer : public IRenderer
+{
+private:
+    SDL_Window *window = nullptr;
+    SDL_Renderer *renderer = nullptr;
+    SDL_Texture *frame = nullptr;
+    SoftRaster raster;
+
+public:
+    explicit SDL2SoftRenderer(const RendererConfig &cfg)
+        : raster(cfg.width, cfg.height)
+    {
+        if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0)
+            throw std::runtime_error(std::string("SDL_Init failed: ") + SDL_GetError());
+        window = SDL_CreateWindow("Screensaver - OpenMP (raster por software) [F11 fullscreen, ESC]", SDL_WINDOWPOS_CENTERED,
+                                  SDL_WINDOWPOS_CENTERED, cfg.width, cfg.height, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+        if (!window)
+        {
+            SDL_Quit();
+            throw std::runtime_error(std::string("SDL_CreateWindow failed: ") + SDL_GetError());
+        }
+        Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+        if (cfg.vsync)
+            rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+        renderer = SDL_CreateRenderer(window, -1, rendererFlags);
+        if (!renderer)
+        {
+            SDL_DestroyWindow(window);
+            SDL_Quit();
+            throw std::runtime_error(std::string("SDL_CreateRenderer failed: ") + SDL_GetError());
+        }
+        createFrameTexture();
+    }
+
+    ~SDL2SoftRenderer()
+    {
+        if (frame)
+            SDL_DestroyTexture(frame);
+        if (renderer)
+            SDL_DestroyRenderer(renderer);
+        if (window)
+            SDL_DestroyWindow(window);
+        SDL_Quit();
+    }
+
+    void beginFrame() override
+    {
+        PROF_ZONE("render_begin");
+        SDL_Event e;
+        while (SDL_PollEvent(&e))
+        {
+            if (e.type == SDL_WINDOWEVENT &&
+                (e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED || e.window.event == SDL_WINDOWEVENT_RESIZED))
+            {
+                createFrameTexture();
+            }
+            else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F11)
+            {
+                const Uint32 flags = SDL_GetWindowFlags(window);
+                SDL_SetWindowFullscreen(window, (flags & SDL_WINDOW_FULLSCREEN_DESKTOP) ? 0 : SDL_WINDOW_FULLSCREEN_DESKTOP);
+                createFrameTexture();
+            }
+            else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE)
+            {
+                SDL_Event quit;
+                quit.type = SDL_QUIT;
+                SDL_PushEvent(&quit);
+            }
+        }
+    }
+
+    void drawState(const State &s) override
+    {
+        PROF_ZONE("render_draw");
+        void *pixels = nullptr;
+        int pitch = 0;
+        if (SDL_LockTexture(frame, nullptr, &pixels, &pitch) != 0)
+            return;
+        raster.draw(s, static_cast<uint32_t *>(pixels), pitch / int(sizeof(uint32_t)));
+        SDL_UnlockTexture(frame);
+    }
+
+    void endFrame() override
+    {
+        PROF_ZONE("render_present");
+        SDL_RenderCopy(renderer, frame, nullptr, nullptr);
+        SDL_RenderPresent(renderer);
+    }
+
+private:
+    // Textura del tamaño actual de la ventana (la pantalla completa cambia el tamaño)
+    void createFrameTexture()
+    {
+        int w = 0, h = 0;
+        SDL_GetWindowSize(window, &w, &h);
+        if (frame && w == raster.width() && h == raster.height())
+            return;
+        if (frame)
+            SDL_DestroyTexture(frame);
+        frame = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, w, h);
+        if (!frame)
+            throw std::runtime_error(std::string("SDL_CreateTexture failed: ") + SDL_GetError());
+        raster.resize(w, h);
+    }
+};
+
+// Factory function
+RendererPtr createRenderer(const RendererConfig &cfg) { return std::make_unique<SDL2SoftRenderer>(cfg); }
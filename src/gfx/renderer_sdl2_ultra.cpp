@@ -1,39 +1,27 @@
 #include "gfx/renderer.hpp"
+#include "gfx/trail_ring.hpp"
+#include "core/grid.hpp"
+#include "core/profile.hpp"
 #include <SDL2/SDL.h>
 #include <memory>
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
 #include <vector>
-#include <deque>
 #include <random>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Las partículas se envían en lotes con SDL_RenderGeometry (SDL 2.0.18+)
+#if !SDL_VERSION_ATLEAST(2, 0, 18)
+#error "renderer_sdl2 requiere SDL >= 2.0.18 (SDL_RenderGeometry)"
+#endif
 
 // =============== Utilidades ===============
 constexpr float PI = 3.14159265359f;
 constexpr float TWO_PI = 2.0f * PI;
 
-struct ParticleTrail
-{
-    std::deque<std::pair<float, float>> positions;
-    std::deque<uint32_t> colors;
-    static constexpr size_t MAX_TRAIL_LENGTH = 30;
-    void addPosition(float x, float y, uint32_t color)
-    {
-        positions.push_front({x, y});
-        colors.push_front(color);
-        if (positions.size() > MAX_TRAIL_LENGTH)
-        {
-            positions.pop_back();
-            colors.pop_back();
-        }
-    }
-    void clear()
-    {
-        positions.clear();
-        colors.clear();
-    }
-};
-
 class SDL2UltraRenderer : public IRenderer
 {
 private:
@@ -46,11 +34,35 @@ private:
     SDL_Texture *trailTexture = nullptr;      // acumulación de estelas
     SDL_Texture *glowTexture = nullptr;       // bloom barato
     SDL_Texture *backgroundTexture = nullptr; // fondo valle nocturno
+    SDL_Texture *glowSprite = nullptr;        // halo de una partícula (blanco, alfa radial)
+
+    // Lotes de geometría: cada quad son 4 vértices (a-b un lado, c-d el opuesto) que comparten el
+    // mismo patrón de 6 índices. Un frame del modo clásico son unas pocas llamadas a SDL_RenderGeometry
+    // en lugar de ~100 llamadas de dibujo por partícula.
+    static constexpr int BATCH_QUADS = 16384;
+    static constexpr int GLOW_SPRITE_SIZE = 32;
+    static constexpr float GLOW_RADIUS = 8.5f;
+    std::vector<SDL_Vertex> solidBatch, glowBatch;
+    std::vector<int> quadIndices;
+
+    // Conexiones: grid propio del renderer (celdas del lado del radio de conexión) y quads por hilo.
+    // MAX_LINKS acota las líneas por frame sin acortar el radio. Si los pares esperados pasan de
+    // MAX_LINKS / 2, solo se conecta un subconjunto de partículas elegido por hash del id (el mismo en
+    // cada frame y parejo en toda la pantalla) con ~MAX_LINKS / 2 pares esperados; las demás no tienen
+    // líneas. El tope duro es por celda, MAX_LINKS / celdas líneas (el doble del promedio): solo en
+    // celdas mucho más densas que el resto se omiten sus últimos pares en orden de sorted.
+    static constexpr int MAX_LINKS = 20000;
+    Grid linkGrid{1, 1, 1};
+    std::vector<int> linkStart, linkIdx; // partículas conectables por celda (rangos contiguos, CSR)
+    std::vector<std::vector<SDL_Vertex>> linkQuads;
 
     // Estado general
-    std::vector<ParticleTrail> trails; // para modo clásico
+    TrailRing trails; // para modo clásico
     float time = 0.0f;
     int frameCount = 0;
+    // Duración medida del frame anterior (s) para animar con tiempo de pared y no por número de frames
+    float frameDt = 0.0f;
+    Uint64 lastCounter = 0;
 
     // Escena valle
     struct Star
@@ -124,7 +136,17 @@ public:
             throw std::runtime_error(std::string("SDL_CreateRenderer failed: ") + SDL_GetError());
         }
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-        
+
+        quadIndices.resize(size_t(BATCH_QUADS) * 6);
+        for (int q = 0; q < BATCH_QUADS; ++q)
+        {
+            const int v = q * 4, k = q * 6;
+            quadIndices[k + 0] = v + 0; quadIndices[k + 1] = v + 1; quadIndices[k + 2] = v + 2;
+            quadIndices[k + 3] = v + 2; quadIndices[k + 4] = v + 1; quadIndices[k + 5] = v + 3;
+        }
+        solidBatch.reserve(size_t(BATCH_QUADS) * 4);
+        glowBatch.reserve(size_t(BATCH_QUADS) * 4);
+
         // Inicialización completa
         initializeResources();
         
@@ -159,6 +181,10 @@ private:
             SDL_DestroyTexture(backgroundTexture);
             backgroundTexture = nullptr;
         }
+        if (glowSprite) {
+            SDL_DestroyTexture(glowSprite);
+            glowSprite = nullptr;
+        }
     }
     
     void initializeResources()
@@ -183,9 +209,7 @@ private:
             initializeResources();
             
             // Limpiar trails cuando cambia el tamaño
-            for (auto& trail : trails) {
-                trail.clear();
-            }
+            trails.clear();
         }
     }
 
@@ -196,7 +220,8 @@ private:
         glowTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
         backgroundTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
         
-        if (!trailTexture || !glowTexture || !backgroundTexture) {
+        glowSprite = createGlowSprite();
+        if (!trailTexture || !glowTexture || !backgroundTexture || !glowSprite) {
             throw std::runtime_error(std::string("Failed to create textures: ") + SDL_GetError());
         }
         
@@ -211,6 +236,29 @@ private:
         SDL_SetRenderTarget(renderer, nullptr);
     }
 
+    // Halo pre-renderizado: blanco con alfa 64*(1 - d/R), el mismo perfil que los anillos de puntos
+    // de antes; el color de cada partícula lo pone el color de vértice (modula la textura)
+    SDL_Texture *createGlowSprite()
+    {
+        const int n = GLOW_SPRITE_SIZE;
+        std::vector<Uint8> pixels(size_t(n) * n * 4);
+        for (int y = 0; y < n; ++y)
+            for (int x = 0; x < n; ++x)
+            {
+                const float dx = (x + 0.5f) / (0.5f * n) - 1.0f, dy = (y + 0.5f) / (0.5f * n) - 1.0f;
+                const float t = std::clamp(1.0f - std::sqrt(dx * dx + dy * dy), 0.0f, 1.0f);
+                Uint8 *p = &pixels[(size_t(y) * n + x) * 4];
+                p[0] = p[1] = p[2] = 255;
+                p[3] = Uint8(64.0f * t);
+            }
+        SDL_Texture *tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, n, n);
+        if (!tex)
+            return nullptr;
+        SDL_UpdateTexture(tex, nullptr, pixels.data(), n * 4);
+        SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+        return tex;
+    }
+
     static float smoothNoise1D(int x, int seed = 0)
     {
         int n = x + seed * 57;
@@ -351,8 +399,13 @@ public:
     // ---------- Ciclo de render ----------
     void beginFrame() override
     {
+        PROF_ZONE("render_begin");
         handleEvents();
-        time += 0.016f;
+        const Uint64 now = SDL_GetPerformanceCounter();
+        // Acotado para que una pausa (arrastre de ventana, breakpoint) no dispare la animación
+        frameDt = lastCounter ? std::min(0.1f, float(double(now - lastCounter) / double(SDL_GetPerformanceFrequency()))) : 0.0f;
+        lastCounter = now;
+        time += frameDt;
         ++frameCount;
         switch (visualMode)
         {
@@ -368,21 +421,23 @@ public:
 
     void drawState(const State &s) override
     {
+        PROF_ZONE("render_draw");
         if (visualMode == MODE_FIREWORKS)
         {
             drawFireworksMode();
             return;
         }
-        // Modo clásico (usa el State original)
-        if (trails.size() != size_t(s.N))
-            trails.resize(s.N);
+        // Modo clásico (usa el State original). Las estelas se indexan por id estable
+        // para que sigan a su partícula aunque el State se reordene.
+        if (trails.n != s.N)
+            trails.reset(s.N);
         drawClassicMode(s);
-        for (int i = 0; i < s.N; ++i)
-            trails[i].addPosition(s.x[i], s.y[i], s.color[i]);
+        trails.push(s);
     }
 
     void endFrame() override
     {
+        PROF_ZONE("render_present");
         if (visualMode == MODE_FIREWORKS)
             applyBloomEffect();
         SDL_RenderPresent(renderer);
@@ -429,78 +484,245 @@ private:
         SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     }
 
+    // ---------- Lotes ----------
+    static SDL_Vertex vertex(float x, float y, SDL_Color c, float u = 0.0f, float v = 0.0f)
+    {
+        return SDL_Vertex{SDL_FPoint{x, y}, c, SDL_FPoint{u, v}};
+    }
+
+    void pushQuad(std::vector<SDL_Vertex> &batch, SDL_Texture *tex,
+                  const SDL_Vertex &a, const SDL_Vertex &b, const SDL_Vertex &c, const SDL_Vertex &d)
+    {
+        batch.push_back(a);
+        batch.push_back(b);
+        batch.push_back(c);
+        batch.push_back(d);
+        if (batch.size() >= size_t(BATCH_QUADS) * 4)
+            flushBatch(batch, tex);
+    }
+
+    void flushBatch(std::vector<SDL_Vertex> &batch, SDL_Texture *tex)
+    {
+        if (batch.empty())
+            return;
+        const int quads = int(batch.size() / 4);
+        SDL_RenderGeometry(renderer, tex, batch.data(), int(batch.size()), quadIndices.data(), quads * 6);
+        batch.clear();
+    }
+
+    // Agrega quads ya armados (4 vértices cada uno) al lote, enviándolo cada BATCH_QUADS
+    void appendQuads(std::vector<SDL_Vertex> &batch, SDL_Texture *tex, const std::vector<SDL_Vertex> &quads)
+    {
+        const size_t cap = size_t(BATCH_QUADS) * 4;
+        for (size_t k = 0; k < quads.size();)
+        {
+            const size_t n = std::min(quads.size() - k, cap - batch.size());
+            batch.insert(batch.end(), quads.begin() + k, quads.begin() + k + n);
+            k += n;
+            if (batch.size() >= cap)
+                flushBatch(batch, tex);
+        }
+    }
+
+    // Quad de un rectángulo sólido
+    static void rectQuad(std::vector<SDL_Vertex> &out, float x, float y, float w, float h, SDL_Color c)
+    {
+        out.push_back(vertex(x, y, c));
+        out.push_back(vertex(x + w, y, c));
+        out.push_back(vertex(x, y + h, c));
+        out.push_back(vertex(x + w, y + h, c));
+    }
+
+    // Quad de un segmento de 1 px de ancho, con el color de cada extremo (degradado a lo largo)
+    static void segmentQuad(std::vector<SDL_Vertex> &out, float x0, float y0, float x1, float y1, SDL_Color c0, SDL_Color c1)
+    {
+        const float dx = x1 - x0, dy = y1 - y0;
+        const float len2 = dx * dx + dy * dy;
+        if (len2 < 1e-6f)
+            return;
+        const float k = 0.5f / std::sqrt(len2);
+        const float px = -dy * k, py = dx * k;
+        out.push_back(vertex(x0 + px, y0 + py, c0));
+        out.push_back(vertex(x0 - px, y0 - py, c0));
+        out.push_back(vertex(x1 + px, y1 + py, c1));
+        out.push_back(vertex(x1 - px, y1 - py, c1));
+    }
+
+    // Rectángulo sólido (sin textura)
+    void pushRect(float x, float y, float w, float h, SDL_Color c)
+    {
+        rectQuad(solidBatch, x, y, w, h, c);
+        if (solidBatch.size() >= size_t(BATCH_QUADS) * 4)
+            flushBatch(solidBatch, nullptr);
+    }
+
+    // Segmento de 1 px de ancho en el lote sólido
+    void pushSegment(float x0, float y0, float x1, float y1, SDL_Color c0, SDL_Color c1)
+    {
+        segmentQuad(solidBatch, x0, y0, x1, y1, c0, c1);
+        if (solidBatch.size() >= size_t(BATCH_QUADS) * 4)
+            flushBatch(solidBatch, nullptr);
+    }
+
     // ---------- Clásico ----------
     void drawClassicMode(const State &s)
     {
-        // Trails de líneas
-        for (int i = 0; i < s.N; ++i)
         {
-            auto &tr = trails[i];
-            for (size_t j = 1; j < tr.positions.size(); ++j)
+            // Trails de líneas: más transparentes y oscuros hacia la cola
+            PROF_ZONE("render_trails");
+            auto fade = [](uint32_t c, float a) {
+                return SDL_Color{Uint8(((c >> 16) & 0xFF) * a), Uint8(((c >> 8) & 0xFF) * a), Uint8((c & 0xFF) * a), Uint8(255 * a * a)};
+            };
+            // De la cola a la cabeza (lo más reciente queda encima), una pareja de filas a la vez
+            const float inv = 1.0f / float(std::max(1, trails.count));
+            for (int age = trails.count - 1; age >= 1; --age)
             {
-                float a = 1.0f - float(j) / float(tr.positions.size());
-                uint32_t c = tr.colors[j];
-                Uint8 r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
-                SDL_SetRenderDrawColor(renderer, Uint8(r * a), Uint8(g * a), Uint8(b * a), Uint8(255 * a * a));
-                SDL_RenderDrawLine(renderer, int(tr.positions[j - 1].first), int(tr.positions[j - 1].second), int(tr.positions[j].first), int(tr.positions[j].second));
+                const float *x0 = &trails.x[trails.row(age - 1)], *y0 = &trails.y[trails.row(age - 1)];
+                const float *x1 = &trails.x[trails.row(age)], *y1 = &trails.y[trails.row(age)];
+                const uint32_t *c0 = &trails.color[trails.row(age - 1)], *c1 = &trails.color[trails.row(age)];
+                const float a0 = 1.0f - float(age - 1) * inv, a1 = 1.0f - float(age) * inv;
+                for (int i = 0; i < trails.n; ++i)
+                    pushSegment(x0[i], y0[i], x1[i], y1[i], fade(c0[i], a0), fade(c1[i], a1));
             }
+            flushBatch(solidBatch, nullptr);
         }
         drawParticlesWithGlow(s);
         drawConnections(s, 150.0f);
+        flushBatch(solidBatch, nullptr);
     }
     void drawParticlesWithGlow(const State &s)
     {
+        PROF_ZONE("render_particles");
+        // Halos: un quad texturizado por partícula, teñido con su color
         for (int i = 0; i < s.N; ++i)
         {
-            uint32_t c = s.color[i];
-            Uint8 r = (c >> 16) & 0xFF, g = (c >> 8) & 0xFF, b = c & 0xFF;
-            for (int radius = 8; radius > 0; --radius)
-            {
-                Uint8 a = Uint8(64 * (1.0f - float(radius) / 8.0f));
-                SDL_SetRenderDrawColor(renderer, r, g, b, a);
-                for (int ang = 0; ang < 360; ang += 30)
-                {
-                    float rad = ang * PI / 180.0f;
-                    int px = int(s.x[i] + radius * std::cos(rad));
-                    int py = int(s.y[i] + radius * std::sin(rad));
-                    SDL_RenderDrawPoint(renderer, px, py);
-                }
-            }
-            SDL_SetRenderDrawColor(renderer, std::min(255, int(r) + 100), std::min(255, int(g) + 100), std::min(255, int(b) + 100), 255);
-            SDL_Rect core = {int(s.x[i] - 2), int(s.y[i] - 2), 5, 5};
-            SDL_RenderFillRect(renderer, &core);
+            const uint32_t c = s.color[i];
+            const SDL_Color col{Uint8((c >> 16) & 0xFF), Uint8((c >> 8) & 0xFF), Uint8(c & 0xFF), 255};
+            const float x0 = s.x[i] - GLOW_RADIUS, y0 = s.y[i] - GLOW_RADIUS;
+            const float x1 = s.x[i] + GLOW_RADIUS, y1 = s.y[i] + GLOW_RADIUS;
+            pushQuad(glowBatch, glowSprite, vertex(x0, y0, col, 0.0f, 0.0f), vertex(x1, y0, col, 1.0f, 0.0f),
+                     vertex(x0, y1, col, 0.0f, 1.0f), vertex(x1, y1, col, 1.0f, 1.0f));
+        }
+        flushBatch(glowBatch, glowSprite);
+        // Núcleos: cuadrado sólido más claro (van en el lote sólido, encima de los halos)
+        for (int i = 0; i < s.N; ++i)
+        {
+            const uint32_t c = s.color[i];
+            const SDL_Color core{Uint8(std::min(255u, ((c >> 16) & 0xFF) + 100)), Uint8(std::min(255u, ((c >> 8) & 0xFF) + 100)),
+                                 Uint8(std::min(255u, (c & 0xFF) + 100)), 255};
+            pushRect(s.x[i] - 2.5f, s.y[i] - 2.5f, 5.0f, 5.0f, core);
         }
     }
+    // Mezcla de 32 bits (finalizador tipo murmur) para elegir partículas conectables de forma estable
+    static uint32_t hashId(uint32_t v)
+    {
+        v ^= v >> 16;
+        v *= 0x7feb352du;
+        v ^= v >> 15;
+        v *= 0x846ca68bu;
+        v ^= v >> 16;
+        return v;
+    }
+    // Une pares de partículas a menos de maxDist. Un grid con celdas de lado maxDist enumera solo
+    // pares vecinos (celda propia y media estrella: E, SO, S, SE), así cada par se ve una vez. Con N
+    // grande se conecta solo una fracción de las partículas (ver MAX_LINKS), lo que acota también el
+    // costo de recorrer los pares; la opacidad siempre se desvanece contra maxDist.
+    // El límite no depende de los hilos: cada hilo arma sus quads por filas de celdas (reparto
+    // estático, bandas contiguas) y se envían en orden de hilo, que es el orden de las filas.
     void drawConnections(const State &s, float maxDist)
     {
-        float maxSq = maxDist * maxDist;
-        for (int i = 0; i < s.N - 1; ++i)
+        PROF_ZONE("render_connections");
+        if (s.N < 2)
+            return;
+        const float maxSq = maxDist * maxDist;
+        Grid &g = linkGrid;
+        g.tile(s.width, s.height, maxDist);
+        g.buildSorted(s);
+
+        // Pares esperados con densidad uniforme; si pasan de la meta cada partícula entra con
+        // probabilidad sqrt(meta / pares), así los pares entre las elegidas son ~meta
+        const double area = double(s.width) * double(s.height);
+        const double pairs = 0.5 * double(s.N) * double(s.N - 1) * std::min(1.0, double(PI) * maxSq / area);
+        const double target = 0.5 * MAX_LINKS;
+        const double keep = pairs > target ? std::sqrt(target / pairs) : 1.0;
+        const uint32_t threshold = uint32_t(keep * 4294967295.0);
+        const int cells = g.rows * g.cols;
+        linkStart.resize(size_t(cells) + 1);
+        linkIdx.clear();
+        for (int c = 0; c < cells; ++c)
         {
-            for (int j = i + 1; j < std::min(i + 30, s.N); ++j)
-            {
-                float dx = s.x[i] - s.x[j], dy = s.y[i] - s.y[j];
-                float d2 = dx * dx + dy * dy;
-                if (d2 < maxSq)
+            linkStart[size_t(c)] = int(linkIdx.size());
+            const int *p = g.sorted.data() + g.cellStart[c];
+            for (int k = 0; k < g.cellCount[c]; ++k)
+                if (keep >= 1.0 || hashId(uint32_t(s.id[p[k]])) <= threshold)
+                    linkIdx.push_back(p[k]);
+        }
+        linkStart[size_t(cells)] = int(linkIdx.size());
+        const int cellCap = std::max(1, MAX_LINKS / cells);
+
+        int nThreads = 1;
+#ifdef _OPENMP
+        nThreads = omp_get_max_threads();
+#endif
+        linkQuads.resize(size_t(nThreads));
+        #pragma omp parallel num_threads(nThreads)
+        {
+            int t = 0;
+#ifdef _OPENMP
+            t = omp_get_thread_num();
+#endif
+            std::vector<SDL_Vertex> &out = linkQuads[size_t(t)];
+            out.clear();
+            int links = 0; // líneas de la celda actual
+            auto link = [&](int i, int j) {
+                const float dx = s.x[i] - s.x[j], dy = s.y[i] - s.y[j];
+                const float d2 = dx * dx + dy * dy;
+                if (d2 >= maxSq)
+                    return;
+                ++links;
+                float a = 1.0f - std::sqrt(d2) / maxDist;
+                a = a * a * a;
+                const uint32_t c1 = s.color[i], c2 = s.color[j];
+                const Uint8 r = ((c1 >> 16) & 0xFF) / 2 + ((c2 >> 16) & 0xFF) / 2;
+                const Uint8 gr = ((c1 >> 8) & 0xFF) / 2 + ((c2 >> 8) & 0xFF) / 2;
+                const Uint8 b = (c1 & 0xFF) / 2 + (c2 & 0xFF) / 2;
+                const SDL_Color line{r, gr, b, Uint8(a * 150)};
+                segmentQuad(out, s.x[i], s.y[i], s.x[j], s.y[j], line, line);
+                if (a > 0.5f)
+                {
+                    const float mx = (s.x[i] + s.x[j]) / 2, my = (s.y[i] + s.y[j]) / 2;
+                    rectQuad(out, mx - 1.5f, my - 1.5f, 3.0f, 3.0f, SDL_Color{255, 255, 255, Uint8(a * 100)});
+                }
+            };
+            static const int FWD[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+            #pragma omp for schedule(static)
+            for (int cy = 0; cy < g.rows; ++cy)
+                for (int cx = 0; cx < g.cols; ++cx)
                 {
-                    float d = std::sqrt(d2);
-                    float a = 1.0f - (d / maxDist);
-                    a = a * a * a;
-                    uint32_t c1 = s.color[i], c2 = s.color[j];
-                    Uint8 r = ((c1 >> 16) & 0xFF) / 2 + ((c2 >> 16) & 0xFF) / 2;
-                    Uint8 g = ((c1 >> 8) & 0xFF) / 2 + ((c2 >> 8) & 0xFF) / 2;
-                    Uint8 b = (c1 & 0xFF) / 2 + (c2 & 0xFF) / 2;
-                    SDL_SetRenderDrawColor(renderer, r, g, b, Uint8(a * 150));
-                    SDL_RenderDrawLine(renderer, int(s.x[i]), int(s.y[i]), int(s.x[j]), int(s.y[j]));
-                    if (a > 0.5f)
+                    const int c = cy * g.cols + cx;
+                    const int *p = linkIdx.data() + linkStart[size_t(c)];
+                    const int n = linkStart[size_t(c) + 1] - linkStart[size_t(c)];
+                    links = 0;
+                    for (int a = 0; a < n && links < cellCap; ++a)
                     {
-                        int mx = int((s.x[i] + s.x[j]) / 2), my = int((s.y[i] + s.y[j]) / 2);
-                        SDL_SetRenderDrawColor(renderer, 255, 255, 255, Uint8(a * 100));
-                        SDL_Rect mid = {mx - 1, my - 1, 3, 3};
-                        SDL_RenderFillRect(renderer, &mid);
+                        for (int b = a + 1; b < n && links < cellCap; ++b)
+                            link(p[a], p[b]);
+                        for (const auto &d : FWD)
+                        {
+                            const int nx = cx + d[0], ny = cy + d[1];
+                            if (nx < 0 || nx >= g.cols || ny >= g.rows)
+                                continue;
+                            const int nc = ny * g.cols + nx;
+                            const int *q = linkIdx.data() + linkStart[size_t(nc)];
+                            const int m = linkStart[size_t(nc) + 1] - linkStart[size_t(nc)];
+                            for (int b = 0; b < m && links < cellCap; ++b)
+                                link(p[a], q[b]);
+                        }
                     }
                 }
-            }
         }
+        for (const auto &quads : linkQuads)
+            appendQuads(solidBatch, nullptr, quads);
     }
 
     // ---------- Fuegos artificiales ----------
@@ -566,7 +788,7 @@ private:
 
     void updateFireworks()
     {
-        const float dt = 0.016f;
+        const float dt = frameDt;
         const float g = 260.0f; // caída más suave
 
         // lanzamientos un poco más espaciados
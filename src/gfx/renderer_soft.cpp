@@ -0,0 +1,60 @@
+// src/gfx/renderer_soft.cpp
+#include "gfx/renderer.hpp"
+#include "gfx/frame_encoder.hpp"
+#include "gfx/soft_raster.hpp"
+#include "core/profile.hpp"
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Renderer sin ventana: rasteriza el modo clásico en un framebuffer en memoria (con todos los hilos
+// OpenMP). Sirve para medir el costo real del render en máquinas sin pantalla (CI, servidores) y para
+// validar la imagen: con RendererConfig::output guarda el último frame al terminar o, con frameEvery > 0,
+// uno de cada frameEvery frames mediante un FrameEncoder en segundo plano (PNG o PPM según la extensión).
+class SoftwareRenderer : public IRenderer {
+public:
+    explicit SoftwareRenderer(const RendererConfig& cfg)
+      : raster(cfg.width, cfg.height), frameEvery(cfg.frameEvery),
+        framebuffer(size_t(cfg.width) * cfg.height) {
+        if (!cfg.output.empty()) encoder = std::make_unique<FrameEncoder>(cfg.output);
+    }
+
+    ~SoftwareRenderer() override {
+        if (!encoder || frames == 0) return;
+        if (frameEvery == 0) encoder->submit(framebuffer.data(), raster.width(), raster.height(), frames);
+        encoder->flush();
+        if (frameEvery == 0 && encoder->written() == 1)
+            std::cout << "Frame written: " << encoder->path_for(frames) << "\n";
+        else if (frameEvery > 0)
+            std::cout << "Frames: escritos=" << encoder->written() << " omitidos=" << encoder->skipped()
+                      << " fallidos=" << encoder->failed() << "\n";
+        if (encoder->failed() > 0) std::cerr << "[warn] No se pudieron escribir frames en " << encoder->path_for(frames) << "\n";
+    }
+
+    void beginFrame() override {}
+
+    void drawState(const State& s) override {
+        PROF_ZONE("render_draw");
+        raster.draw(s, framebuffer.data(), raster.width());
+        ++frames;
+    }
+
+    void endFrame() override {
+        if (encoder && frameEvery > 0 && frames % frameEvery == 0) {
+            PROF_ZONE("render_dump");
+            encoder->submit(framebuffer.data(), raster.width(), raster.height(), frames);
+        }
+    }
+
+private:
+    SoftRaster raster;
+    int frameEvery;
+    std::vector<uint32_t> framebuffer;  // ARGB8888, pitch = ancho
+    std::unique_ptr<FrameEncoder> encoder;
+    long long frames = 0;
+};
+
+// Crea una instancia del renderizador
+RendererPtr createRenderer(const RendererConfig& cfg) {
+    return std::make_unique<SoftwareRenderer>(cfg);
+}
@@ -0,0 +1,187 @@
+// src/gfx/soft_raster.cpp
+#include "soft_raster.hpp"
+#include "core/profile.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr uint32_t BLACK = 0xFF000000u;
+
+// Escala de alfa 0..255 a 0..256, para dividir con >> 8 (a = 255 deja el color intacto)
+inline uint32_t alpha256(uint32_t a) { return a + (a >> 7); }
+
+// c*a/256 por canal, con R y B empaquetados en una sola multiplicación (a256 en 0..256)
+inline uint32_t scale(uint32_t c, uint32_t a256) {
+    return (((c & 0xFF00FFu) * a256 >> 8) & 0xFF00FFu) | (((c & 0x00FF00u) * a256 >> 8) & 0x00FF00u);
+}
+
+// dst = src*a + dst*(1-a) por canal (a en 0..255)
+inline uint32_t blend(uint32_t d, uint32_t c, uint32_t a) {
+    const uint32_t a1 = alpha256(a), ia = 256 - a1;
+    const uint32_t rb = ((c & 0xFF00FFu) * a1 + (d & 0xFF00FFu) * ia) >> 8;
+    const uint32_t g  = ((c & 0x00FF00u) * a1 + (d & 0x00FF00u) * ia) >> 8;
+    return BLACK | (rb & 0xFF00FFu) | (g & 0x00FF00u);
+}
+
+// Área de píxeles [x0, x1) x [y0, y1) de un tile
+struct Rect { int x0, y0, x1, y1; };
+
+// Segmento de 1 px (DDA) con color y alfa interpolados entre los extremos, recortado al tile
+inline void draw_segment(uint32_t* px, int pitch, const Rect& t, float xa, float ya, float xb, float yb,
+                         uint32_t ca, float aa, uint32_t cb, float ab) {
+    if (std::max(xa, xb) < t.x0 || std::min(xa, xb) >= t.x1 ||
+        std::max(ya, yb) < t.y0 || std::min(ya, yb) >= t.y1) return;
+    const float dx = xb - xa, dy = yb - ya;
+    const int steps = std::max(1, int(std::ceil(std::max(std::fabs(dx), std::fabs(dy)))));
+    const float inv = 1.0f / float(steps);
+    for (int k = 0; k <= steps; ++k) {
+        const float u = float(k) * inv;
+        const int x = int(xa + dx*u), y = int(ya + dy*u);
+        if (x < t.x0 || x >= t.x1 || y < t.y0 || y >= t.y1) continue;
+        // Como en el renderer SDL: rgb*a y alfa a^2 (más tenue hacia la cola)
+        const uint32_t a = uint32_t((aa + (ab - aa)*u) * 256.0f);
+        uint32_t& d = px[size_t(y)*pitch + x];
+        d = blend(d, scale(u < 0.5f ? ca : cb, a), (a*a*255) >> 16);
+    }
+}
+
+} // namespace
+
+SoftRaster::SoftRaster(int width, int height) : w(0), h(0), tiles(1, 1, 1) {
+    for (int dy = -GLOW_RADIUS; dy <= GLOW_RADIUS; ++dy)
+        for (int dx = -GLOW_RADIUS; dx <= GLOW_RADIUS; ++dx) {
+            const float t = 1.0f - std::sqrt(float(dx*dx + dy*dy)) / (GLOW_RADIUS + 0.5f);
+            glowAlpha[dy + GLOW_RADIUS][dx + GLOW_RADIUS] = uint8_t(64.0f * std::max(t, 0.0f));
+        }
+    resize(width, height);
+}
+
+void SoftRaster::resize(int width, int height) {
+    if (width == w && height == h) return;
+    w = width; h = height;
+    tiles.tile(w, h, float(TILE));
+    trails.clear();
+}
+
+void SoftRaster::draw(const State& s, uint32_t* pixels, int pitch) {
+    PROF_ZONE("raster");
+    const int n = s.N;
+    if (trails.n != n) {
+        trails.reset(n);
+        boxX0.resize(n); boxY0.resize(n); boxX1.resize(n); boxY1.resize(n);
+        ptX.resize(size_t(TrailRing::MAX_TRAIL_LENGTH) * n); ptY.resize(size_t(TrailRing::MAX_TRAIL_LENGTH) * n);
+        ptColor.resize(size_t(TrailRing::MAX_TRAIL_LENGTH) * n);
+    }
+    trails.push(s);
+
+    {
+        PROF_ZONE("raster_bin");
+        tiles.buildSorted(s);
+    }
+
+    // Estelas permutadas al orden CSR (fila 'age' contigua por slot): los tiles leen las partículas
+    // de cada celda seguidas en vez de saltar por id en el anillo. Cada fila del anillo cabe en
+    // caché, así que la permutación se hace fila por fila. De paso, la caja de estela+halo de cada
+    // slot y el alcance máximo desde la posición actual: un tile solo mira las celdas a 'reach' tiles.
+    float reachPx = 0.0f;
+    {
+        PROF_ZONE("raster_gather");
+        const int count = trails.count;
+        const int* sorted = tiles.sorted.data();
+        const float g = float(GLOW_RADIUS + 1);
+        #pragma omp parallel if(n>16384)
+        {
+            // Mismo reparto estático en todos los bucles: cada hilo toca siempre los mismos slots
+            for (int age = 0; age < count; ++age) {
+                const size_t src = trails.row(age), dst = size_t(age) * n;
+                #pragma omp for schedule(static) nowait
+                for (int k = 0; k < n; ++k) {
+                    const int id = s.id[sorted[k]];
+                    const float x = trails.x[src + id], y = trails.y[src + id];
+                    ptX[dst + k] = x; ptY[dst + k] = y; ptColor[dst + k] = trails.color[src + id];
+                    if (age == 0) { boxX0[k] = boxX1[k] = x; boxY0[k] = boxY1[k] = y; }
+                    else {
+                        boxX0[k] = std::min(boxX0[k], x); boxX1[k] = std::max(boxX1[k], x);
+                        boxY0[k] = std::min(boxY0[k], y); boxY1[k] = std::max(boxY1[k], y);
+                    }
+                }
+            }
+            #pragma omp for schedule(static) reduction(max:reachPx)
+            for (int k = 0; k < n; ++k) {
+                const float cx = ptX[k], cy = ptY[k];
+                reachPx = std::max(reachPx, std::max(std::max(cx - boxX0[k], boxX1[k] - cx),
+                                                     std::max(cy - boxY0[k], boxY1[k] - cy)) + g);
+                boxX0[k] -= g; boxY0[k] -= g; boxX1[k] += g; boxY1[k] += g;
+            }
+        }
+    }
+    const int reach = std::min(std::max(tiles.cols, tiles.rows), int(std::ceil(reachPx / float(TILE))));
+
+    PROF_ZONE("raster_tiles");
+    const int nTiles = tiles.cols * tiles.rows;
+    #pragma omp parallel
+    {
+        std::vector<int> cand;
+        #pragma omp for schedule(dynamic, 1)
+        for (int t = 0; t < nTiles; ++t)
+            drawTile(t, reach, cand, pixels, pitch);
+    }
+}
+
+void SoftRaster::drawTile(int tile, int reach, std::vector<int>& cand, uint32_t* pixels, int pitch) const {
+    const int tx = tile % tiles.cols, ty = tile / tiles.cols;
+    const Rect r{ tx*TILE, ty*TILE, std::min((tx+1)*TILE, w), std::min((ty+1)*TILE, h) };
+    if (r.x0 >= r.x1 || r.y0 >= r.y1) return;
+
+    for (int y = r.y0; y < r.y1; ++y)
+        std::fill(pixels + size_t(y)*pitch + r.x0, pixels + size_t(y)*pitch + r.x1, BLACK);
+
+    // Slots de las celdas vecinas cuya caja toca el tile (en orden CSR: estable)
+    cand.clear();
+    for (int cy = std::max(0, ty - reach); cy <= std::min(tiles.rows - 1, ty + reach); ++cy)
+        for (int cx = std::max(0, tx - reach); cx <= std::min(tiles.cols - 1, tx + reach); ++cx) {
+            const int c = cy*tiles.cols + cx;
+            for (int k = tiles.cellStart[c]; k < tiles.cellStart[c] + tiles.cellCount[c]; ++k)
+                if (boxX1[k] >= r.x0 && boxX0[k] < r.x1 && boxY1[k] >= r.y0 && boxY0[k] < r.y1)
+                    cand.push_back(k);
+        }
+
+    // 1) Estelas, de la cola a la cabeza (lo más reciente queda encima)
+    const float inv = 1.0f / float(std::max(1, trails.count));
+    for (int age = trails.count - 1; age >= 1; --age) {
+        const size_t ra = size_t(age - 1) * trails.n, rb = size_t(age) * trails.n;
+        const float aa = 1.0f - float(age - 1)*inv, ab = 1.0f - float(age)*inv;
+        for (int k : cand)
+            draw_segment(pixels, pitch, r, ptX[ra + k], ptY[ra + k], ptX[rb + k], ptY[rb + k],
+                         ptColor[ra + k], aa, ptColor[rb + k], ab);
+    }
+
+    // 2) Halos con el color de la partícula
+    for (int k : cand) {
+        const int cx = int(ptX[k]), cy = int(ptY[k]);
+        const int x0 = std::max(r.x0, cx - GLOW_RADIUS), x1 = std::min(r.x1, cx + GLOW_RADIUS + 1);
+        const int y0 = std::max(r.y0, cy - GLOW_RADIUS), y1 = std::min(r.y1, cy + GLOW_RADIUS + 1);
+        const uint32_t c = ptColor[k];
+        for (int y = y0; y < y1; ++y) {
+            uint32_t* row = pixels + size_t(y)*pitch;
+            const uint8_t* ga = glowAlpha[y - cy + GLOW_RADIUS];
+            for (int x = x0; x < x1; ++x)
+                row[x] = blend(row[x], c, ga[x - cx + GLOW_RADIUS]);
+        }
+    }
+
+    // 3) Núcleos opacos 5x5, más claros
+    for (int k : cand) {
+        const int cx = int(ptX[k]), cy = int(ptY[k]);
+        const int x0 = std::max(r.x0, cx - 2), x1 = std::min(r.x1, cx + 3);
+        const int y0 = std::max(r.y0, cy - 2), y1 = std::min(r.y1, cy + 3);
+        const uint32_t c = ptColor[k];
+        const uint32_t core = BLACK | (std::min(255u, ((c >> 16) & 0xFF) + 100) << 16)
+                                    | (std::min(255u, ((c >> 8) & 0xFF) + 100) << 8)
+                                    |  std::min(255u, (c & 0xFF) + 100);
+        if (x0 >= x1) continue;
+        for (int y = y0; y < y1; ++y)
+            std::fill(pixels + size_t(y)*pitch + x0, pixels + size_t(y)*pitch + x1, core);
+    }
+}
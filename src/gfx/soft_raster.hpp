@@ -0,0 +1,42 @@
+// src/gfx/soft_raster.hpp
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "core/grid.hpp"
+#include "core/state.hpp"
+#include "gfx/trail_ring.hpp"
+
+// Rasterizador por software del modo clásico (estelas, halos y núcleos) sobre un framebuffer
+// ARGB8888 en memoria (propio o el de una textura bloqueada). La pantalla se divide en tiles de
+// TILE x TILE píxeles, que son las celdas de un Grid: las partículas se clasifican por tile con
+// Grid::buildSorted y cada hilo OpenMP rasteriza tiles completos recortando a su tile lo que dibuja.
+// Ningún píxel lo escriben dos hilos y la imagen no depende del número de hilos.
+class SoftRaster {
+public:
+    static constexpr int TILE = 64;
+    static constexpr int GLOW_RADIUS = 8;
+
+    SoftRaster(int width, int height);
+
+    // Cambia el tamaño del framebuffer (las estelas se reinician)
+    void resize(int width, int height);
+    int width() const { return w; }
+    int height() const { return h; }
+
+    // Agrega s a las estelas y dibuja el frame completo en pixels (pitch = píxeles por fila)
+    void draw(const State& s, uint32_t* pixels, int pitch);
+
+private:
+    void drawTile(int tile, int reach, std::vector<int>& cand, uint32_t* pixels, int pitch) const;
+
+    int w, h;
+    Grid tiles;
+    TrailRing trails;
+    // Por slot CSR de 'tiles', recalculados en cada frame: estelas (fila age * n + slot; la fila 0 es
+    // la posición actual) y caja que cubre la estela y el halo
+    std::vector<float> ptX, ptY;
+    std::vector<uint32_t> ptColor;
+    std::vector<float> boxX0, boxY0, boxX1, boxY1;
+    // Alfa del halo por desplazamiento entero al centro: 64*(1 - d/R), el perfil del renderer SDL
+    uint8_t glowAlpha[2*GLOW_RADIUS+1][2*GLOW_RADIUS+1];
+};
@@ -0,0 +1,62 @@
+// src/gfx/trail_ring.hpp
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "core/state.hpp"
+
+// Estelas de todas las partículas en un anillo SoA plano: la fila r guarda x, y y color de las N
+// partículas (indexadas por id estable) en un frame. 'head' es la fila más reciente; agregar un frame
+// es copiar el State a la fila siguiente, y dibujar recorre cada fila de forma contigua.
+struct TrailRing
+{
+    static constexpr int MAX_TRAIL_LENGTH = 30;
+    int n = 0;
+    int head = 0;  // fila del frame más reciente
+    int count = 0; // frames guardados (<= MAX_TRAIL_LENGTH)
+    std::vector<float> x, y;
+    std::vector<uint32_t> color;
+
+    void reset(int particles)
+    {
+        n = particles;
+        x.assign(size_t(MAX_TRAIL_LENGTH) * n, 0.0f);
+        y.assign(size_t(MAX_TRAIL_LENGTH) * n, 0.0f);
+        color.assign(size_t(MAX_TRAIL_LENGTH) * n, 0u);
+        clear();
+    }
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+    // Fila del frame de antigüedad 'age' (0 = más reciente)
+    size_t row(int age) const { return size_t((head - age + MAX_TRAIL_LENGTH) % MAX_TRAIL_LENGTH) * n; }
+
+    void push(const State &s)
+    {
+        head = (head + 1) % MAX_TRAIL_LENGTH;
+        count = std::min(count + 1, MAX_TRAIL_LENGTH);
+        float *rx = &x[row(0)], *ry = &y[row(0)];
+        uint32_t *rc = &color[row(0)];
+        // Sin reordenamiento el id es la identidad: la fila es una copia directa del State
+        int i = 0;
+        while (i < n && s.id[i] == i)
+            ++i;
+        if (i == n)
+        {
+            std::memcpy(rx, s.x.data(), sizeof(float) * n);
+            std::memcpy(ry, s.y.data(), sizeof(float) * n);
+            std::memcpy(rc, s.color.data(), sizeof(uint32_t) * n);
+            return;
+        }
+        for (i = 0; i < n; ++i)
+        {
+            const int id = s.id[i];
+            rx[id] = s.x[i];
+            ry[id] = s.y[i];
+            rc[id] = s.color[i];
+        }
+    }
+};
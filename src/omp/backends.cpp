@@ -0,0 +1,26 @@
+#include "backends.hpp"
+#include "update_seq.hpp"
+#include "update_omp_for.hpp"
+#include "update_omp_simd.hpp"
+#include "update_omp_tasks.hpp"
+#include "update_ws_tiles.hpp"
+#include "update_compact.hpp"
+
+// Registro de backends: para agregar uno nuevo basta con añadirlo aquí
+const std::vector<Backend>& backends() {
+    static const std::vector<Backend> list = {
+        { "seq",       "integrate+grid_update",         update_step_seq },
+        { "omp_for",   "integrate+grid_sorted",         update_step_omp_for },
+        { "omp_simd",  "integrate+grid_update",         update_step_omp_simd },
+        { "omp_tasks", "integrate+grid_sorted+collide", update_step_omp_tasks },
+        { "ws_tiles",  "integrate+grid_sorted+collide", update_step_ws_tiles },
+        { "compact",   "integrate_fixed",               update_step_compact, sync_compact },
+    };
+    return list;
+}
+
+const Backend* find_backend(const std::string& name) {
+    for (const auto& b : backends())
+        if (name == b.name) return &b;
+    return nullptr;
+}
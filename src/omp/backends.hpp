@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "core/state.hpp"
+#include "core/sim_context.hpp"
+
+// Firma común de todos los backends de actualización
+using StepFn = void (*)(State&, SimContext&);
+
+// Entrada del registro de backends
+struct Backend {
+    const char* name;
+    // Trabajo de cada paso (no todos hacen lo mismo): integrar+rebotar, grid incremental (grid_update)
+    // o CSR (grid_sorted), colisiones Gauss-Seidel (collide). Va en el reporte y en --summary.
+    const char* workload;
+    StepFn step;
+    // Opcional: deja el State al día antes de dibujarlo o copiarlo (backends que simulan en otro formato)
+    StepFn sync = nullptr;
+};
+
+// Lista de todos los backends disponibles en este binario
+const std::vector<Backend>& backends();
+// Busca un backend por nombre; nullptr si no existe
+const Backend* find_backend(const std::string& name);
@@ -0,0 +1,34 @@
+#include "update_compact.hpp"
+#include "core/physics.hpp"
+#include "core/compact_state.hpp"
+#include "core/profile.hpp"
+#include <algorithm>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+// Integración + rebotes sobre el almacenamiento compacto de 16 bits (10 bytes por partícula
+// leídos y escritos en lugar de 16). El State float solo se actualiza en sync_compact.
+// No construye el grid ni resuelve colisiones (el grid necesita las posiciones float): la carga es
+// la misma que seq/omp_for/omp_simd sin la construcción del grid.
+void update_step_compact(State& s, SimContext& ctx) {
+    const float dt = ctx.dt;
+    CompactState& c = ctx.compact;
+    // (Re)cuantizar si no hay copia vigente (inicio, reordenamiento) o cambió N / la caja
+    if (!c.live || int(c.px.size()) != s.N || c.width != s.width || c.height != s.height) {
+        PROF_ZONE("compact_pack");
+        compact_pack(s, c);
+    }
+    const int nb = (s.N + KERNEL_BLOCK - 1) / KERNEL_BLOCK;
+    PROF_ZONE("compact_integrate_bounce");
+    #pragma omp parallel for schedule(runtime) if(s.N>256)
+    for (int b=0;b<nb;b++) {
+        compact_integrate_bounce(c, s.N, dt, b*KERNEL_BLOCK, std::min(s.N, (b+1)*KERNEL_BLOCK));
+    }
+}
+
+void sync_compact(State& s, SimContext& ctx) {
+    if (!ctx.compact.live) return;
+    PROF_ZONE("compact_unpack");
+    compact_unpack(ctx.compact, s);
+}
@@ -0,0 +1,6 @@
+#pragma once
+#include "core/state.hpp"
+#include "core/sim_context.hpp"
+void update_step_compact(State& s, SimContext& ctx);
+// Copia la versión compacta de vuelta a los float del State (antes de dibujar o copiar el State)
+void sync_compact(State& s, SimContext& ctx);
@@ -1,28 +1,32 @@
 #include "update_omp_for.hpp"
 #include "core/physics.hpp"
 #include "core/grid.hpp"
+#include "core/profile.hpp"
+#include <algorithm>
 #ifdef _OPENMP
     #include <omp.h>
 #endif
 
 // Actualiza posiciones y velocidades usando OpenMP. Reajusta límites y reconstruye la grilla.
-void update_step_omp_for(State& s) {
-    const float dt = 1.0f/60.0f;
-    // Actualiza posiciones y velocidades
-    #pragma omp parallel for if(s.N>256) schedule(runtime)
-    for (int i=0;i<s.N;i++) {
-        s.x[i] += s.vx[i]*dt;
-        s.y[i] += s.vy[i]*dt;
+// Todo el frame corre en una sola región paralela: un fork/join por paso en lugar de uno por bucle.
+void update_step_omp_for(State& s, SimContext& ctx) {
+    const float dt = ctx.dt;
+    Grid& g = ctx.grid;
+    fit_grid(ctx.grid, s);
+    const int nb = (s.N + KERNEL_BLOCK - 1) / KERNEL_BLOCK;
+    #pragma omp parallel if(s.N>256)
+    {
+        // Integración + condiciones de frontera fusionadas, repartidas en bloques de KERNEL_BLOCK.
+        // nowait: buildSortedTeam arranca con una barrera antes de leer posiciones.
+        {
+            PROF_ZONE("integrate_bounce");
+            #pragma omp for schedule(runtime) nowait
+            for (int b=0;b<nb;b++) {
+                integrate_bounce(s, dt, b*KERNEL_BLOCK, std::min(s.N, (b+1)*KERNEL_BLOCK));
+            }
+        }
+        // Grid CSR construido por el mismo equipo (histograma, prefix sum y scatter en paralelo)
+        PROF_ZONE("grid_build_sorted");
+        g.buildSortedTeam(s);
     }
-    // Uso de condiciones de frontera
-    #pragma omp parallel for if(s.N>256) schedule(runtime)
-    for (int i=0;i<s.N;i++) {
-        if (s.x[i] < 0.f) { s.x[i]=0.f; s.vx[i] = -s.vx[i]; }
-        if (s.x[i] > s.width) { s.x[i]=float(s.width); s.vx[i] = -s.vx[i]; }
-        if (s.y[i] < 0.f) { s.y[i]=0.f; s.vy[i] = -s.vy[i]; }
-        if (s.y[i] > s.height){ s.y[i]=float(s.height); s.vy[i] = -s.vy[i]; }
-    }
-    // Reconstrucción de la cuadrícula
-    Grid g(s.width, s.height, 64);
-    g.build(s);
-}
\ No newline at end of file
+}
@@ -1,3 +1,4 @@
 #pragma once
 #include "core/state.hpp"
-void update_step_omp_for(State& s);
\ No newline at end of file
+#include "core/sim_context.hpp"
+void update_step_omp_for(State& s, SimContext& ctx);
\ No newline at end of file
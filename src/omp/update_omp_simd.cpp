@@ -1,36 +1,30 @@
 #include "update_omp_simd.hpp"
 #include "core/physics.hpp"
 #include "core/grid.hpp"
+#include "core/profile.hpp"
+#include <algorithm>
 #ifdef _OPENMP
   #include <omp.h>
 #endif
 
 // Actualiza posiciones y velocidades usando OpenMP. Reajusta límites y reconstruye la grilla.
-void update_step_omp_simd(State& s) {
-    const float dt = 1.0f/60.0f;
-    // Actualiza posiciones y velocidades
+void update_step_omp_simd(State& s, SimContext& ctx) {
+    const float dt = ctx.dt;
+    fit_grid(ctx.grid, s);
+    // Kernel fusionado con SIMD explícito (AVX-512/AVX2/SSE2 según el CPU) por bloque
+    const int nb = (s.N + KERNEL_BLOCK - 1) / KERNEL_BLOCK;
     #pragma omp parallel
     {
-      #pragma omp for schedule(runtime)
-      for (int i=0;i<s.N;i++) {
-        #pragma omp simd
-        for (int k=0;k<1;k++) { // simd forzado sobre la operación (truco simple)
-          s.x[i] += s.vx[i]*dt;
-          s.y[i] += s.vy[i]*dt;
+        {
+            PROF_ZONE("integrate_bounce");
+            #pragma omp for schedule(runtime) nowait
+            for (int b=0;b<nb;b++) {
+                integrate_bounce(s, dt, b*KERNEL_BLOCK, std::min(s.N, (b+1)*KERNEL_BLOCK));
+            }
         }
-      }
-      // Uso de condiciones de frontera
-      #pragma omp for schedule(runtime)
-      for (int i=0;i<s.N;i++) {
-        float xi=s.x[i], yi=s.y[i];
-        if (xi < 0.f) { xi=0.f; s.vx[i] = -s.vx[i]; }
-        if (xi > s.width) { xi=float(s.width); s.vx[i] = -s.vx[i]; }
-        if (yi < 0.f) { yi=0.f; s.vy[i] = -s.vy[i]; }
-        if (yi > s.height){ yi=float(s.height); s.vy[i] = -s.vy[i]; }
-        s.x[i]=xi; s.y[i]=yi;
-      }
+        PROF_BARRIER("barrier");
     }
-    // Reconstrucción de la cuadrícula
-    Grid g(s.width, s.height, 64);
-    g.build(s);
+    // Actualización incremental de la cuadrícula persistente
+    PROF_ZONE("grid_update");
+    ctx.grid.update(s);
 }
\ No newline at end of file
@@ -1,46 +1,51 @@
 #include "update_omp_tasks.hpp"
 #include "core/physics.hpp"
 #include "core/grid.hpp"
+#include "core/profile.hpp"
+#include <algorithm>
 #ifdef _OPENMP
   #include <omp.h>
 #endif
 
 // Actualiza posiciones y velocidades usando OpenMP. Reajusta límites y reconstruye la grilla.
-void update_step_omp_tasks(State& s) {
-    const float dt = 1.0f/60.0f;
-    // Integración + rebotes en paralelo (igual que omp_for)
+void update_step_omp_tasks(State& s, SimContext& ctx) {
+    const float dt = ctx.dt;
+    fit_grid(ctx.grid, s);
+    // Integración + rebotes, grid CSR y colisiones dentro de una sola región paralela
     #pragma omp parallel
     {
-      #pragma omp for schedule(guided)
-      for (int i=0;i<s.N;i++) {
-        s.x[i] += s.vx[i]*dt;
-        s.y[i] += s.vy[i]*dt;
+      const int nb = (s.N + KERNEL_BLOCK - 1) / KERNEL_BLOCK;
+      {
+        PROF_ZONE("integrate_bounce");
+        #pragma omp for schedule(guided) nowait
+        for (int b=0;b<nb;b++) {
+          integrate_bounce(s, dt, b*KERNEL_BLOCK, std::min(s.N, (b+1)*KERNEL_BLOCK));
+        }
       }
-      #pragma omp for schedule(guided)
-      for (int i=0;i<s.N;i++) {
-        if (s.x[i] < 0.f) { s.x[i]=0.f; s.vx[i] = -s.vx[i]; }
-        if (s.x[i] > s.width) { s.x[i]=float(s.width); s.vx[i] = -s.vx[i]; }
-        if (s.y[i] < 0.f) { s.y[i]=0.f; s.vy[i] = -s.vy[i]; }
-        if (s.y[i] > s.height){ s.y[i]=float(s.height); s.vy[i] = -s.vy[i]; }
+      // Construir el grid CSR con el mismo equipo de hilos (empieza con barrera, por eso el nowait)
+      Grid& g = ctx.grid;
+      {
+        PROF_ZONE("grid_build_sorted");
+        g.buildSortedTeam(s);
       }
-    }
-    // Construir grid y procesar por celdas con tasks
-    Grid g(s.width, s.height, 64);
-    g.build(s);
 
-    // Procesar colisiones por celda
-    #pragma omp parallel
-    {
-      #pragma omp single nowait
-      for (int cy=0; cy<g.rows; ++cy) {
-        for (int cx=0; cx<g.cols; ++cx) {
-          #pragma omp task firstprivate(cx,cy) shared(g,s)
-          {
-            int head = g.head[cy*g.cols + cx];
-            // TODO: Procesar colisiones en la celda
-            (void)head;
+      // Procesar colisiones por celda. Cada celda escribe en columnas cx-1..cx+1 y filas cy..cy+1,
+      // así que coloreando por (cx%3, cy%2) las tareas de un mismo color nunca se pisan.
+      #pragma omp single
+      for (int color=0; color<6; ++color) {
+        // Zona por color (incluye el taskwait): una zona por tarea llenaría el ring buffer
+        PROF_ZONE("collide_color");
+        const int ox = color % 3, oy = color / 3;
+        for (int cy=oy; cy<g.rows; cy+=2) {
+          for (int cx=ox; cx<g.cols; cx+=3) {
+            // Celdas vacías no generan tarea
+            if (g.cellCount[cy*g.cols + cx] == 0) continue;
+            #pragma omp task firstprivate(cx,cy) shared(g,s)
+            collide_cell(s, g, cx, cy, PARTICLE_RADIUS);
           }
         }
+        // Barrera entre colores
+        #pragma omp taskwait
       }
     }
 }
\ No newline at end of file
@@ -1,3 +1,4 @@
 #pragma once
 #include "core/state.hpp"
-void update_step_omp_tasks(State& s);
\ No newline at end of file
+#include "core/sim_context.hpp"
+void update_step_omp_tasks(State& s, SimContext& ctx);
\ No newline at end of file
@@ -1,12 +1,15 @@
-
 #include "update_seq.hpp"
 #include "core/physics.hpp"
 #include "core/grid.hpp"
+#include "core/profile.hpp"
 
 // Actualiza el estado del sistema: integra física, aplica rebotes y organiza objetos en una cuadrícula espacial.
-void update_step_seq(State& s) {
-    integrate(s, 1.0f/60.0f);
-    bounce(s);
-    Grid g(s.width, s.height, 64);
-    g.build(s);
-}
\ No newline at end of file
+void update_step_seq(State& s, SimContext& ctx) {
+    fit_grid(ctx.grid, s);
+    {
+        PROF_ZONE("integrate_bounce");
+        integrate_bounce(s, ctx.dt, 0, s.N);
+    }
+    PROF_ZONE("grid_update");
+    ctx.grid.update(s);
+}
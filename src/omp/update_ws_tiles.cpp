@@ -0,0 +1,114 @@
+#include "update_ws_tiles.hpp"
+#include "core/physics.hpp"
+#include "core/grid.hpp"
+#include "core/profile.hpp"
+#include "core/work_stealing.hpp"
+#include <algorithm>
+#include <memory>
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+namespace {
+
+// Partículas por tarea en el paso por partícula (integrar y rebotar)
+constexpr int PARTICLE_TASK = 4096;
+// Tiles por hilo: suficientes para que el robo de trabajo compense el desbalance
+constexpr int TILES_PER_THREAD = 8;
+
+// Respeta --threads (omp_set_num_threads) para comparar con los backends OpenMP
+int pool_threads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    unsigned hc = std::thread::hardware_concurrency();
+    return hc == 0 ? 1 : int(hc);
+#endif
+}
+
+// Pool persistente entre frames; se recrea solo si cambia el número de hilos
+WorkStealingPool& pool() {
+    static std::unique_ptr<WorkStealingPool> p;
+    const int T = pool_threads();
+    if (!p || p->threads() != T) p = std::make_unique<WorkStealingPool>(T);
+    return *p;
+}
+
+// Parte las celdas (en orden de fila, que en CSR son rangos contiguos de sorted) en tiles de costo
+// parecido. Costo de una celda ~ partículas * partículas en su vecindad 3x3, más 1 por visitarla.
+void build_tiles(const Grid& g, int workers, std::vector<int>& tiles) {
+    const int cells = g.cols*g.rows;
+    long long total = 0;
+    std::vector<long long> cost(cells);
+    for (int cy = 0; cy < g.rows; ++cy) {
+        for (int cx = 0; cx < g.cols; ++cx) {
+            const int c = cy*g.cols + cx;
+            long long nb = 0;
+            if (g.cellCount[c] > 0) {
+                for (int ry = std::max(0, cy-1); ry <= std::min(g.rows-1, cy+1); ++ry)
+                    nb += g.cellStart[ry*g.cols + std::min(g.cols-1, cx+1) + 1] - g.cellStart[ry*g.cols + std::max(0, cx-1)];
+            }
+            cost[c] = 1 + (long long)g.cellCount[c] * nb;
+            total += cost[c];
+        }
+    }
+    const long long target = std::max<long long>(1, total / ((long long)workers * TILES_PER_THREAD));
+    tiles.clear();
+    tiles.push_back(0);
+    long long acc = 0;
+    for (int c = 0; c < cells; ++c) {
+        acc += cost[c];
+        if (acc >= target) { tiles.push_back(c+1); acc = 0; }
+    }
+    if (tiles.back() != cells) tiles.push_back(cells);
+}
+
+} // namespace
+
+// Backend con pool propio de robo de trabajo (sin OpenMP en las fases): integra, construye el grid
+// CSR por fases y resuelve colisiones por tiles adaptativos, un color de celdas a la vez.
+void update_step_ws_tiles(State& s, SimContext& ctx) {
+    const float dt = ctx.dt;
+    WorkStealingPool& wp = pool();
+    const int P = wp.threads();
+    const int nTasks = (s.N + PARTICLE_TASK - 1) / PARTICLE_TASK;
+    Grid& g = ctx.grid;
+    fit_grid(ctx.grid, s);
+
+    {
+        PROF_ZONE("integrate_bounce");
+        wp.run(nTasks, [&](int t) {
+            integrate_bounce(s, dt, t*PARTICLE_TASK, std::min(s.N, (t+1)*PARTICLE_TASK));
+        });
+    }
+    {
+        PROF_ZONE("grid_build_sorted");
+        const int cells = g.cols*g.rows;
+        g.csrPrepare(s, P);
+        wp.run(P, [&](int p) { g.csrHistogram(s, p, P); });
+        wp.run(P, [&](int p) {
+            g.csrOffsets(int(int64_t(cells)*p/P), int(int64_t(cells)*(p+1)/P), P);
+        });
+        g.csrPrefix();
+        wp.run(P, [&](int p) { g.csrScatter(s, p, P); });
+    }
+    {
+        // Gauss-Seidel coloreado como omp_tasks: collide_cell escribe en las columnas cx-1..cx+1 y
+        // filas cy..cy+1, así que las celdas de un mismo color (cx%3, cy%2) nunca se pisan. Cada par se
+        // resuelve una sola vez y aplica el mismo impulso a ambas partículas (conserva energía y
+        // momento). Los tiles adaptativos se reparten con robo de trabajo dentro de cada color.
+        PROF_ZONE("collide_tiles");
+        build_tiles(g, P, ctx.tiles);
+        const auto& tiles = ctx.tiles;
+        for (int color = 0; color < 6; ++color) {
+            const int ox = color % 3, oy = color / 3;
+            wp.run(int(tiles.size()) - 1, [&](int t) {
+                for (int c = tiles[t]; c < tiles[t+1]; ++c) {
+                    const int cx = c % g.cols, cy = c / g.cols;
+                    if (cx % 3 != ox || cy % 2 != oy || g.cellCount[c] == 0) continue;
+                    collide_cell(s, g, cx, cy, PARTICLE_RADIUS);
+                }
+            });
+        }
+    }
+}
@@ -0,0 +1,4 @@
+#pragma once
+#include "core/state.hpp"
+#include "core/sim_context.hpp"
+void update_step_ws_tiles(State& s, SimContext& ctx);
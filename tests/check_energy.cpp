@@ -0,0 +1,32 @@
+// tests/check_energy.cpp
+// Verifica que cada backend conserve la energía cinética: los choques son elásticos entre partículas de
+// igual masa y los rebotes solo cambian el signo de la velocidad, así que la energía solo puede variar
+// por redondeo. Sale con 1 si algún backend se aleja más de TOLERANCE de la energía inicial.
+#include "omp/backends.hpp"
+#include <cmath>
+#include <cstdio>
+
+static double kinetic_energy(const State& s) {
+    double e = 0.0;
+    for (int i = 0; i < s.N; ++i) e += 0.5 * (double(s.vx[i])*s.vx[i] + double(s.vy[i])*s.vy[i]);
+    return e;
+}
+
+int main() {
+    constexpr int N = 20000, STEPS = 300;
+    constexpr double TOLERANCE = 1e-3;
+    int failures = 0;
+    for (const Backend& b : backends()) {
+        State s(N, 1280, 720, 42);
+        SimContext ctx(s.width, s.height);
+        if (b.sync) { b.step(s, ctx); b.sync(s, ctx); }  // formatos propios: medir desde su primer paso
+        const double e0 = kinetic_energy(s);
+        for (int k = 0; k < STEPS; ++k) b.step(s, ctx);
+        if (b.sync) b.sync(s, ctx);
+        const double e1 = kinetic_energy(s), rel = std::fabs(e1 - e0) / e0;
+        const bool ok = std::isfinite(e1) && rel <= TOLERANCE;
+        std::printf("%-10s E0=%.6g E=%.6g rel=%.2e %s\n", b.name, e0, e1, rel, ok ? "ok" : "FALLA");
+        if (!ok) ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}